@@ -0,0 +1,304 @@
+#pragma once
+
+#include "Image.h"
+#include "Filter.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Box and Gaussian blurs whose cost per pixel does not depend on the radius. A box is a running
+// sum that gains the sample entering the window and loses the one leaving it; a Gaussian is three
+// boxes in a row, sized so their combined variance matches sigma².
+namespace blur
+{
+    namespace __detail
+    {
+        // Columns handled together by the vertical passes
+        constexpr int STRIP = 64;
+
+        // Sample index standing in for each window position -r .. n - 1 + r, or -1 for a zero
+        inline std::vector<int> window(int n, int radius, filter::Border border)
+        {
+            std::vector<int> indices(n + 2 * radius + 1);
+
+            for (int i = 0; i < (int)indices.size(); i++)
+            {
+                indices[i] = filter::__detail::source(i - radius, n, border);
+            }
+
+            return indices;
+        }
+
+        // One box along a line of n samples, in[i * step], into out[i * step]. Window sums, here
+        // and in the column passes, are kept in double: they change by one difference per sample,
+        // and a float sum drifts by a few thousandths of a level over a couple of hundred thousand
+        // samples.
+        inline void slide(const float *in, float *out, int n, int step, int radius, const std::vector<int> &indices, std::vector<float> &line)
+        {
+            float scale = 1.0f / (2 * radius + 1);
+
+            for (int i = 0; i < (int)indices.size(); i++)
+            {
+                line[i] = indices[i] < 0 ? 0.0f : in[indices[i] * step];
+            }
+
+            double sum = 0;
+
+            for (int i = 0; i <= 2 * radius; i++)
+            {
+                sum += line[i];
+            }
+
+            for (int i = 0; i < n; i++)
+            {
+                out[i * step] = static_cast<float>(sum) * scale;
+                sum += (double)line[i + 2 * radius + 1] - line[i];
+            }
+        }
+
+        // Every horizontal pass of a row runs in two line buffers, so the image is read and
+        // written once however many boxes there are
+        inline void rows(const filter::Plane &plane, filter::Plane &result, const std::vector<int> &radii, filter::Border border, parallel::Execution execution)
+        {
+            int width = plane.width;
+
+            std::vector<std::vector<int>> windows;
+
+            for (int radius : radii)
+            {
+                windows.push_back(window(width, radius, border));
+            }
+
+            parallel::forEach(plane.height, [&](int begin, int end)
+                              {
+                                  std::vector<float> line(width + 2 * *std::max_element(radii.begin(), radii.end()) + 1), current(width), next(width);
+
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      std::copy_n(&plane.values[y * width], width, current.data());
+
+                                      for (int pass = 0; pass < (int)radii.size(); pass++)
+                                      {
+                                          float *out = pass + 1 == (int)radii.size() ? &result(0, y) : next.data();
+                                          slide(current.data(), out, width, 1, radii[pass], windows[pass], line);
+
+                                          std::swap(current, next);
+                                      }
+                                  }
+                              },
+                              execution);
+        }
+
+        // A strip of columns is copied out once and every vertical pass runs on it while it is in
+        // cache. The running sums of the strip sit side by side in one local array of doubles, so
+        // each step down is a vector add.
+        inline void columns(const filter::Plane &plane, filter::Plane &result, const std::vector<int> &radii, filter::Border border, parallel::Execution execution)
+        {
+            int width = plane.width, height = plane.height;
+
+            std::vector<std::vector<int>> windows;
+
+            for (int radius : radii)
+            {
+                windows.push_back(window(height, radius, border));
+            }
+
+            parallel::forEach((width + STRIP - 1) / STRIP, [&](int begin, int end)
+                              {
+                                  std::vector<float> current(height * STRIP), next(height * STRIP), zeros(STRIP, 0.0f);
+                                  std::vector<const float *> sources;
+
+                                  for (int strip = begin; strip < end; strip++)
+                                  {
+                                      int x = strip * STRIP, count = std::min(STRIP, width - x);
+
+                                      for (int y = 0; y < height; y++)
+                                      {
+                                          std::copy_n(&plane.values[y * width + x], count, &current[y * STRIP]);
+                                      }
+
+                                      for (int pass = 0; pass < (int)radii.size(); pass++)
+                                      {
+                                          const std::vector<int> &indices = windows[pass];
+                                          int radius = radii[pass];
+                                          float scale = 1.0f / (2 * radius + 1);
+                                          bool last = pass + 1 == (int)radii.size();
+
+                                          sources.resize(indices.size());
+
+                                          for (int i = 0; i < (int)indices.size(); i++)
+                                          {
+                                              sources[i] = indices[i] < 0 ? zeros.data() : &current[indices[i] * STRIP];
+                                          }
+
+                                          double sum[STRIP] = {};
+                                          float out[STRIP];
+
+                                          for (int i = 0; i <= 2 * radius; i++)
+                                          {
+                                              for (int j = 0; j < STRIP; j++)
+                                              {
+                                                  sum[j] += sources[i][j];
+                                              }
+                                          }
+
+                                          for (int y = 0; y < height; y++)
+                                          {
+                                              const float *entering = sources[y + 2 * radius + 1], *leaving = sources[y];
+
+                                              for (int j = 0; j < STRIP; j++)
+                                              {
+                                                  out[j] = static_cast<float>(sum[j]) * scale;
+                                                  sum[j] += (double)entering[j] - leaving[j];
+                                              }
+
+                                              if (last)
+                                              {
+                                                  std::copy_n(out, count, &result(x, y));
+                                              }
+                                              else
+                                              {
+                                                  std::copy_n(out, STRIP, &next[y * STRIP]);
+                                              }
+                                          }
+
+                                          std::swap(current, next);
+                                      }
+                                  }
+                              },
+                              execution);
+        }
+
+        // All horizontal passes, then all vertical ones; each pass applies the border on its own
+        inline filter::Plane boxes(const filter::Plane &plane, std::vector<int> radii, filter::Border border, parallel::Execution execution)
+        {
+            radii.erase(std::remove_if(radii.begin(), radii.end(), [](int radius)
+                                       { return radius <= 0; }),
+                        radii.end());
+
+            if (radii.empty() || plane.width <= 0 || plane.height <= 0)
+            {
+                return plane;
+            }
+
+            filter::Plane across(plane.width, plane.height), result(plane.width, plane.height);
+
+            rows(plane, across, radii, border, execution);
+            columns(across, result, radii, border, execution);
+
+            return result;
+        }
+
+        // Radii of n boxes whose variances, (w² - 1) / 12 each, add up as close to sigma² as odd
+        // widths allow: the first m boxes get the narrower width, the rest the wider one
+        inline std::vector<int> gaussianRadii(float sigma, int n = 3)
+        {
+            if (sigma <= 0)
+            {
+                return {};
+            }
+
+            float variance = sigma * sigma;
+            int lower = static_cast<int>(std::floor(std::sqrt(12 * variance / n + 1)));
+
+            if (lower % 2 == 0)
+            {
+                lower--;
+            }
+
+            int m = static_cast<int>(std::round((12 * variance - n * lower * lower - 4 * n * lower - 3 * n) / (-4.0f * lower - 4)));
+            m = std::clamp(m, 0, n);
+
+            std::vector<int> radii(n);
+
+            for (int i = 0; i < n; i++)
+            {
+                radii[i] = i < m ? (lower - 1) / 2 : (lower + 1) / 2;
+            }
+
+            return radii;
+        }
+
+        inline filter::Plane channel(const ColorImage &image, Byte RGBA::*member, parallel::Execution execution)
+        {
+            filter::Plane plane(image.GetWidth(), image.GetHeight());
+
+            parallel::forEach(plane.height, [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      for (int x = 0; x < plane.width; x++)
+                                      {
+                                          plane(x, y) = image(x, y).*member;
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return plane;
+        }
+
+        inline ColorImage boxes(const ColorImage &image, const std::vector<int> &radii, filter::Border border, parallel::Execution execution)
+        {
+            int width = image.GetWidth(), height = image.GetHeight();
+
+            auto blurred = [&](Byte RGBA::*member)
+            {
+                return boxes(channel(image, member, execution), radii, border, execution);
+            };
+
+            filter::Plane r = blurred(&RGBA::r), g = blurred(&RGBA::g), b = blurred(&RGBA::b), a = blurred(&RGBA::a);
+
+            ColorImage result(width, height);
+
+            parallel::forEach(height, [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      for (int x = 0; x < width; x++)
+                                      {
+                                          result(x, y) = RGBA(filter::__detail::toByte(r(x, y)), filter::__detail::toByte(g(x, y)),
+                                                              filter::__detail::toByte(b(x, y)), filter::__detail::toByte(a(x, y)));
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return result;
+        }
+    }
+
+    // Mean of the (2 * radius + 1)² square around each pixel
+    inline filter::Plane box(const filter::Plane &plane, int radius, filter::Border border = filter::Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::boxes(plane, {radius}, border, execution);
+    }
+
+    inline GrayscaleImage box(const GrayscaleImage &image, int radius, filter::Border border = filter::Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return filter::toImage(box(filter::toPlane(image), radius, border, execution), 1.0f, 0.0f, execution);
+    }
+
+    inline ColorImage box(const ColorImage &image, int radius, filter::Border border = filter::Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::boxes(image, {radius}, border, execution);
+    }
+
+    // Three box passes each way, at the same cost for any sigma. Odd box widths only come close
+    // to sigma, and below about 0.8 there is nothing to blur with.
+    inline filter::Plane gaussian(const filter::Plane &plane, float sigma, filter::Border border = filter::Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::boxes(plane, __detail::gaussianRadii(sigma), border, execution);
+    }
+
+    inline GrayscaleImage gaussian(const GrayscaleImage &image, float sigma, filter::Border border = filter::Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return filter::toImage(gaussian(filter::toPlane(image), sigma, border, execution), 1.0f, 0.0f, execution);
+    }
+
+    inline ColorImage gaussian(const ColorImage &image, float sigma, filter::Border border = filter::Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::boxes(image, __detail::gaussianRadii(sigma), border, execution);
+    }
+}
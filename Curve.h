@@ -3,6 +3,7 @@
 #include "Image.h"
 #include "Line.h"
 #include <array>
+#include <optional>
 
 #ifndef POINT
 #define POINT
@@ -61,108 +62,443 @@ namespace curve
         float x;
         float y;
 
-        operator Point() { return {(int)std::round(x), (int)std::round(y)}; }
+        // Coordinates are clamped to ±2^30 first; the conversion would be undefined past int range
+        operator Point()
+        {
+            const float limit = 1 << 30;
+            return {(int)std::fmin(std::fmax(std::round(x), -limit), limit), (int)std::fmin(std::fmax(std::round(y), -limit), limit)};
+        }
     };
 
     namespace __detail
     {
-        inline FloatPoint lerp(const Point &p1, const Point &p2, const float t)
+        inline FloatPoint lerp(const FloatPoint &p1, const FloatPoint &p2, const float t)
         {
             return {p1.x * t + p2.x * (1 - t), p1.y * t + p2.y * (1 - t)};
         }
 
-        inline float calculateDistance(const Point &p1, const Point &p2)
+        inline float calculateDistance(const FloatPoint &p1, const FloatPoint &p2)
         {
-            return std::sqrt(std::pow(p1.x - p2.x, 2) + std::pow(p1.y - p2.y, 2));
+            float dx = p1.x - p2.x;
+            float dy = p1.y - p2.y;
+            return std::sqrt(dx * dx + dy * dy);
         }
 
         template <int Degree>
-        inline bool isStraight(const BezierCurve<Degree> &curve, float err)
+        using ControlPoints = std::array<FloatPoint, Degree>;
+
+        template <int Degree>
+        inline ControlPoints<Degree> toControlPoints(const BezierCurve<Degree> &curve)
         {
-            float total = 0;
+            ControlPoints<Degree> points;
 
-            int size = curve.points.size() - 1;
+            for (int i = 0; i < Degree; i++)
+            {
+                points[i] = {(float)curve.points[i].x, (float)curve.points[i].y};
+            }
+
+            return points;
+        }
 
-            for (int i = 0; i < size; i++)
+        template <int Degree>
+        inline bool isStraight(const ControlPoints<Degree> &points, float err)
+        {
+            float total = 0;
+
+            for (int i = 0; i < Degree - 1; i++)
             {
-                total += calculateDistance(curve.points[i], curve.points[i + 1]);
+                total += calculateDistance(points[i], points[i + 1]);
             }
 
-            return total / calculateDistance(curve.points[0], curve.points[size]) < err;
+            // Compared as a product so a closed curve (zero chord) is never mistaken for a straight one
+            return total <= err * calculateDistance(points[0], points[Degree - 1]);
         }
 
+        // De Casteljau split in place: `first` receives the left half and `second` the right half.
         template <int Degree>
-        inline std::pair<std::array<Point, Degree>, std::array<Point, Degree>> splitCurve(const BezierCurve<Degree> &curve, float t)
+        inline void splitCurve(const ControlPoints<Degree> &curve, float t, ControlPoints<Degree> &first, ControlPoints<Degree> &second)
         {
-            int size = curve.points.size() - 1;
+            ControlPoints<Degree> points = curve;
 
-            std::vector<FloatPoint> oldPoints, newPoints;
+            for (int size = Degree - 1; size >= 0; size--)
+            {
+                first[Degree - 1 - size] = points[0];
+                second[size] = points[size];
+
+                for (int i = 0; i < size; i++)
+                {
+                    points[i] = lerp(points[i], points[i + 1], t);
+                }
+            }
+        }
 
-            for (const Point &point : curve.points)
+        // Number of uniform segments that keeps the polyline within `tolerance` pixels of the curve
+        // (Wang's formula): n(n - 1) / 8 * max |P[i + 2] - 2 P[i + 1] + P[i]| / N^2 <= tolerance.
+        template <int Degree>
+        inline int estimateSegments(const ControlPoints<Degree> &points, float tolerance)
+        {
+            if constexpr (Degree <= 2)
             {
-                oldPoints.push_back({(float)point.x, (float)point.y});
+                return 1;
             }
+            else
+            {
+                const int order = Degree - 1;
 
-            std::array<Point, Degree> first, second;
+                float maxDifference = 0;
 
-            int firstIndex = 0, secondIndex = size;
+                for (int i = 0; i < Degree - 2; i++)
+                {
+                    float dx = points[i + 2].x - 2 * points[i + 1].x + points[i].x;
+                    float dy = points[i + 2].y - 2 * points[i + 1].y + points[i].y;
+                    maxDifference = std::max(maxDifference, dx * dx + dy * dy);
+                }
 
-            first[firstIndex++] = curve.points[0];
+                float segments = std::sqrt(order * (order - 1) * std::sqrt(maxDifference) / (8 * tolerance));
 
-            second[secondIndex--] = curve.points[size];
+                return std::max(1, (int)std::ceil(segments));
+            }
+        }
 
-            while (size > 0)
+        // Subdivision depth after which every piece is within `tolerance` of its chord
+        template <int Degree>
+        inline int estimateDepth(const ControlPoints<Degree> &points, float tolerance)
+        {
+            return (int)std::ceil(std::log2((float)estimateSegments<Degree>(points, tolerance)));
+        }
+
+        // Calls `emit` with the segments + 1 points at uniform t. The curve is converted once to power
+        // basis so each point is a Horner evaluation of Degree - 1 multiply-adds; forward differencing
+        // would be cheaper still but drifts visibly above cubic degree.
+        template <int Degree, typename Callback>
+        inline void flattenCurve(const ControlPoints<Degree> &points, int segments, Callback emit)
+        {
+            if constexpr (Degree <= 2)
             {
-                for (int i = 0; i < size; i++)
+                emit(points[0]);
+                emit(points[Degree - 1]);
+            }
+            else
+            {
+                const int order = Degree - 1;
+
+                // c[k] = C(n, k) * sum_i (-1)^(k - i) C(k, i) P[i]
+                std::array<double, Degree> x{}, y{};
+
+                double outer = 1;
+
+                for (int k = 0; k <= order; k++)
                 {
-                    newPoints.push_back(lerp(oldPoints[i], oldPoints[i + 1], t));
+                    double inner = 1;
+
+                    for (int i = k; i >= 0; i--)
+                    {
+                        double sign = (k - i) % 2 ? -1 : 1;
+                        x[k] += sign * inner * points[i].x;
+                        y[k] += sign * inner * points[i].y;
+                        inner = inner * i / (k - i + 1);
+                    }
+
+                    x[k] *= outer;
+                    y[k] *= outer;
+                    outer = outer * (order - k) / (k + 1);
                 }
 
-                first[firstIndex++] = newPoints[0];
+                emit(points[0]);
 
-                second[secondIndex--] = newPoints[newPoints.size() - 1];
+                for (int step = 1; step < segments; step++)
+                {
+                    double t = (double)step / segments;
+                    double px = x[order], py = y[order];
 
-                oldPoints = newPoints;
+                    for (int k = order - 1; k >= 0; k--)
+                    {
+                        px = px * t + x[k];
+                        py = py * t + y[k];
+                    }
 
-                newPoints.clear();
+                    emit(FloatPoint{(float)px, (float)py});
+                }
 
-                size--;
+                emit(points[order]);
             }
+        }
 
-            return {first, second};
+        template <typename Image, typename Color, int Degree>
+        inline void drawCurveUniform(Image &image, const BezierCurve<Degree> &curve, Color color, float tolerance)
+        {
+            if (tolerance <= 0)
+            {
+                std::cerr << "Tolerance must be positive." << std::endl;
+                return;
+            }
+
+            ControlPoints<Degree> points = toControlPoints(curve);
+
+            Point previous = curve.points[0];
+
+            flattenCurve<Degree>(points, estimateSegments<Degree>(points, tolerance), [&](FloatPoint point)
+                                 {
+                                     Point next = point;
+
+                                     if (next.x != previous.x || next.y != previous.y)
+                                     {
+                                         line::drawLine(image, previous, next, color);
+                                         previous = next;
+                                     } });
         }
 
         template <typename Image, typename Color, int Degree>
         inline void drawCurve(Image &image, const BezierCurve<Degree> &curve, Color color, float t, float err)
         {
-            std::vector<BezierCurve<Degree>> curves;
-
-            curves.push_back(curve);
+            // Depth-first subdivision never holds more than one pending sibling per level
+            const int maxDepth = 16;
 
-            for (int i = 0; i < curves.size(); i++)
+            struct Segment
             {
-                if (!isStraight(curves[i], err))
-                {
-                    auto split = splitCurve(curves[i], t);
+                ControlPoints<Degree> points;
+                int depth;
+            };
+
+            std::array<Segment, maxDepth + 1> stack;
+            int size = 0;
 
-                    BezierCurve<Degree> firstCurve, secondCurve;
-                    firstCurve.points = split.first;
-                    secondCurve.points = split.second;
+            stack[size++] = {toControlPoints(curve), 0};
 
-                    curves[i] = firstCurve;
-                    curves.insert(curves.begin() + i + 1, secondCurve);
+            // Splitting deeper than a quarter-pixel uniform flattening would need cannot improve the
+            // result, and it bounds the work on curves whose chord is zero
+            int depthLimit = std::min(maxDepth, estimateDepth<Degree>(stack[0].points, 0.25f));
 
-                    i--;
+            Point previous = curve.points[0];
+
+            while (size > 0)
+            {
+                Segment segment = stack[--size];
+
+                if (segment.depth >= depthLimit || isStraight<Degree>(segment.points, err))
+                {
+                    for (int i = 1; i < Degree; i++)
+                    {
+                        Point next = segment.points[i];
+                        line::drawLine(image, previous, next, color);
+                        previous = next;
+                    }
+                    continue;
                 }
+
+                Segment &second = stack[size++];
+                Segment &first = stack[size++];
+
+                splitCurve<Degree>(segment.points, t, first.points, second.points);
+                first.depth = second.depth = segment.depth + 1;
             }
+        }
+
+        struct CurveSample
+        {
+            float t;
+            FloatPoint point;
+        };
 
-            for (const auto &curve : curves)
+        inline bool isFinite(const FloatPoint &point)
+        {
+            return std::isfinite(point.x) && std::isfinite(point.y);
+        }
+
+        // Segments are clipped to this band, four image sizes around the image, before they are
+        // rasterized: what is drawn stays a few image sizes long and far from int overflow,
+        // however far out the curve goes
+        template <typename Image>
+        inline float band(const Image &image)
+        {
+            return 4.0f * std::max(image.GetWidth(), image.GetHeight());
+        }
+
+        // Liang-Barsky: trims [a, b] to the band. False when nothing of it is left.
+        template <typename Image>
+        inline bool clipToBand(const Image &image, FloatPoint &a, FloatPoint &b)
+        {
+            float margin = band(image);
+            float dx = b.x - a.x, dy = b.y - a.y;
+            float enter = 0, leave = 1;
+
+            // Each edge as p * t <= q, with t running from a to b
+            const float p[4] = {-dx, dx, -dy, dy};
+            const float q[4] = {a.x + margin, image.GetWidth() + margin - a.x, a.y + margin, image.GetHeight() + margin - a.y};
+
+            for (int edge = 0; edge < 4; edge++)
             {
-                for (int i = 0; i < curve.points.size() - 1; i++)
+                if (p[edge] == 0)
+                {
+                    if (q[edge] < 0)
+                    {
+                        return false;
+                    }
+
+                    continue;
+                }
+
+                float t = q[edge] / p[edge];
+
+                if (p[edge] < 0)
+                {
+                    enter = std::max(enter, t);
+                }
+                else
                 {
-                    line::drawLine(image, curve.points[i], curve.points[i + 1], color);
+                    leave = std::min(leave, t);
                 }
             }
+
+            if (enter > leave)
+            {
+                return false;
+            }
+
+            FloatPoint start = a;
+
+            a = {start.x + enter * dx, start.y + enter * dy};
+            b = {start.x + leave * dx, start.y + leave * dy};
+
+            return true;
+        }
+
+        // All three points lie beyond the same edge of the image by more than `margin`
+        template <typename Image>
+        inline bool offScreen(const Image &image, const FloatPoint &a, const FloatPoint &b, const FloatPoint &c, float margin)
+        {
+            float left = -margin, right = image.GetWidth() + margin, top = -margin, bottom = image.GetHeight() + margin;
+
+            return (a.x < left && b.x < left && c.x < left) || (a.x >= right && b.x >= right && c.x >= right) ||
+                   (a.y < top && b.y < top && c.y < top) || (a.y >= bottom && b.y >= bottom && c.y >= bottom);
+        }
+
+        // Starts a new polyline at `point` without drawing
+        inline void moveTo(std::optional<FloatPoint> &previous, FloatPoint point)
+        {
+            if (isFinite(point))
+            {
+                previous = point;
+            }
+            else
+            {
+                previous.reset();
+            }
+        }
+
+        // Emits the segment ending at `point`, skipping segments that collapse to the previous
+        // pixel. Only the part of the segment inside the band is drawn; the polyline carries on
+        // from `point` either way.
+        template <typename Image, typename Color>
+        inline void emitSegment(Image &image, std::optional<FloatPoint> &previous, FloatPoint point, Color color)
+        {
+            if (!isFinite(point) || !previous.has_value())
+            {
+                moveTo(previous, point);
+                return;
+            }
+
+            FloatPoint from = previous.value(), to = point;
+
+            if (!clipToBand(image, from, to))
+            {
+                previous = point;
+                return;
+            }
+
+            Point start = from, end = to;
+
+            if (start.x != end.x || start.y != end.y)
+            {
+                line::drawLine(image, start, end, color);
+                previous = point;
+            }
+            else if (from.x != previous->x || from.y != previous->y || to.x != point.x || to.y != point.y)
+            {
+                // A clipped piece too short to show; the next segment starts past the cut
+                previous = point;
+            }
+        }
+
+        // Splits [start, end] at its midpoint until the curve's midpoint lies within `tolerance`
+        // pixels of the chord's midpoint, so flat stretches cost one segment and tight bends get more.
+        template <typename Image, typename Function, typename Color>
+        inline void subdivideParametric(Image &image, Function &function, const CurveSample &start, const CurveSample &end,
+                                        std::optional<FloatPoint> &previous, Color color, float tolerance, int depth)
+        {
+            float t = (start.t + end.t) / 2;
+            FloatPoint middle = function(t);
+
+            float dx = middle.x - (start.point.x + end.point.x) / 2;
+            float dy = middle.y - (start.point.y + end.point.y) / 2;
+
+            // The curve strays from its chord by about as much as its midpoint does, so an interval
+            // whose samples are all further than that past one edge has nothing to draw: jump to
+            // its end instead of refining what would be clipped
+            if (offScreen(image, start.point, middle, end.point, tolerance + std::sqrt(dx * dx + dy * dy)))
+            {
+                moveTo(previous, end.point);
+                return;
+            }
+
+            bool flat = dx * dx + dy * dy <= tolerance * tolerance;
+
+            if (depth <= 0 || (flat && isFinite(middle)))
+            {
+                emitSegment(image, previous, end.point, color);
+                return;
+            }
+
+            subdivideParametric(image, function, start, {t, middle}, previous, color, tolerance, depth - 1);
+            subdivideParametric(image, function, {t, middle}, end, previous, color, tolerance, depth - 1);
+        }
+
+        template <typename Image, typename Function, typename Color>
+        inline void drawParametric(Image &image, Function function, float tStart, float tEnd, Color color, float tolerance, int intervals)
+        {
+            const int maxDepth = 16;
+
+            if (intervals <= 0)
+            {
+                std::cerr << "Intervals must be positive." << std::endl;
+                return;
+            }
+
+            if (tolerance <= 0)
+            {
+                std::cerr << "Tolerance must be positive." << std::endl;
+                return;
+            }
+
+            std::optional<FloatPoint> previous;
+
+            CurveSample start = {tStart, function(tStart)};
+
+            emitSegment(image, previous, start.point, color);
+
+            // The initial uniform intervals keep the midpoint test from missing features that
+            // fold back onto the chord (e.g. a full rose petal between two samples).
+            for (int i = 1; i <= intervals; i++)
+            {
+                float t = tStart + (tEnd - tStart) * i / intervals;
+                CurveSample end = {t, function(t)};
+
+                subdivideParametric(image, function, start, end, previous, color, tolerance, maxDepth);
+
+                start = end;
+            }
+        }
+
+        template <typename Image, typename Function, typename Color>
+        inline void drawPolar(Image &image, const Point &center, Function radius, float thetaStart, float thetaEnd, Color color, float tolerance, int intervals)
+        {
+            auto function = [&](float theta) -> FloatPoint
+            {
+                float r = radius(theta);
+                return {center.x + r * std::cos(theta), center.y + r * std::sin(theta)};
+            };
+
+            drawParametric(image, function, thetaStart, thetaEnd, color, tolerance, intervals);
         }
     }
 
@@ -177,4 +513,46 @@ namespace curve
     {
         __detail::drawCurve(image, curve, color, t, err);
     }
+
+    // Draws the curve as `estimateSegments` uniform steps so its cost depends only on the control
+    // points and `tolerance` (maximum distance in pixels between the curve and the drawn polyline).
+    template <int Degree>
+    inline void drawCurveUniform(GrayscaleImage &image, const BezierCurve<Degree> &curve, Byte color = 255, float tolerance = 0.25f)
+    {
+        __detail::drawCurveUniform(image, curve, color, tolerance);
+    }
+
+    template <int Degree>
+    inline void drawCurveUniform(ColorImage &image, const BezierCurve<Degree> &curve, RGBA color = RGBA(255, 255, 255), float tolerance = 0.25f)
+    {
+        __detail::drawCurveUniform(image, curve, color, tolerance);
+    }
+
+    // Draws the curve (x(t), y(t)) for t in [tStart, tEnd]; `function` maps a float t to a FloatPoint
+    // in image coordinates. Segments are refined adaptively until they deviate from the curve by at
+    // most `tolerance` pixels.
+    template <typename Function>
+    inline void drawParametric(GrayscaleImage &image, Function function, float tStart, float tEnd, Byte color = 255, float tolerance = 0.5f, int intervals = 16)
+    {
+        __detail::drawParametric(image, function, tStart, tEnd, color, tolerance, intervals);
+    }
+
+    template <typename Function>
+    inline void drawParametric(ColorImage &image, Function function, float tStart, float tEnd, RGBA color = RGBA(255, 255, 255), float tolerance = 0.5f, int intervals = 16)
+    {
+        __detail::drawParametric(image, function, tStart, tEnd, color, tolerance, intervals);
+    }
+
+    // Draws the polar curve r(theta) around `center` for theta in [thetaStart, thetaEnd].
+    template <typename Function>
+    inline void drawPolar(GrayscaleImage &image, const Point &center, Function radius, float thetaStart, float thetaEnd, Byte color = 255, float tolerance = 0.5f, int intervals = 16)
+    {
+        __detail::drawPolar(image, center, radius, thetaStart, thetaEnd, color, tolerance, intervals);
+    }
+
+    template <typename Function>
+    inline void drawPolar(ColorImage &image, const Point &center, Function radius, float thetaStart, float thetaEnd, RGBA color = RGBA(255, 255, 255), float tolerance = 0.5f, int intervals = 16)
+    {
+        __detail::drawPolar(image, center, radius, thetaStart, thetaEnd, color, tolerance, intervals);
+    }
 }
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "Image.h"
+#include <array>
+#include <random>
+
+namespace dither
+{
+    // Sub-level thresholds added to a value before it is truncated to 8 bits. BAYER is an 8x8
+    // ordered matrix; BLUE_NOISE tiles a 64x64 void-and-cluster texture, which hides the pattern
+    // better at the same cost.
+    enum class Pattern
+    {
+        NONE = 0,
+        BAYER,
+        BLUE_NOISE
+    };
+
+    namespace __detail
+    {
+        constexpr int BAYER_SIZE = 8;
+        constexpr int NOISE_SIZE = 64;
+
+        // Index matrix built by the recursion M(2n) = [4M, 4M + 2; 4M + 3, 4M + 1], as thresholds in (-0.5, 0.5)
+        inline const std::array<float, BAYER_SIZE * BAYER_SIZE> &bayer()
+        {
+            static const std::array<float, BAYER_SIZE * BAYER_SIZE> table = []
+            {
+                std::array<int, BAYER_SIZE * BAYER_SIZE> index{};
+
+                for (int size = 1; size < BAYER_SIZE; size *= 2)
+                {
+                    for (int y = size - 1; y >= 0; y--)
+                    {
+                        for (int x = size - 1; x >= 0; x--)
+                        {
+                            int m = 4 * index[y * BAYER_SIZE + x];
+
+                            index[y * BAYER_SIZE + x] = m;
+                            index[y * BAYER_SIZE + x + size] = m + 2;
+                            index[(y + size) * BAYER_SIZE + x] = m + 3;
+                            index[(y + size) * BAYER_SIZE + x + size] = m + 1;
+                        }
+                    }
+                }
+
+                std::array<float, BAYER_SIZE * BAYER_SIZE> table;
+
+                for (int i = 0; i < BAYER_SIZE * BAYER_SIZE; i++)
+                {
+                    table[i] = (index[i] + 0.5f) / (BAYER_SIZE * BAYER_SIZE) - 0.5f;
+                }
+
+                return table;
+            }();
+
+            return table;
+        }
+
+        // Ulichney's void-and-cluster method on a torus: points are ranked by repeatedly filling the
+        // emptiest spot, so every threshold level is spread as evenly as possible. Built once, on
+        // first use, from a fixed seed.
+        inline std::vector<float> makeBlueNoise()
+        {
+            const int size = NOISE_SIZE, count = size * size;
+            const float sigma = 1.5f;
+
+            // Gaussian weight by wrapped offset
+            std::vector<float> kernel(count);
+
+            for (int dy = 0; dy < size; dy++)
+            {
+                for (int dx = 0; dx < size; dx++)
+                {
+                    int wx = std::min(dx, size - dx), wy = std::min(dy, size - dy);
+                    kernel[dy * size + dx] = std::exp(-(wx * wx + wy * wy) / (2 * sigma * sigma));
+                }
+            }
+
+            std::vector<char> points(count, 0);
+            std::vector<float> energy(count, 0.0f);
+
+            auto update = [&](int point, float sign)
+            {
+                int px = point % size, py = point / size;
+
+                for (int y = 0; y < size; y++)
+                {
+                    const float *row = &kernel[((y - py + size) % size) * size];
+
+                    for (int x = 0; x < size; x++)
+                    {
+                        energy[y * size + x] += sign * row[(x - px + size) % size];
+                    }
+                }
+
+                points[point] = sign > 0;
+            };
+
+            // Densest point when looking for clusters, emptiest spot when looking for voids
+            auto find = [&](bool cluster)
+            {
+                int best = -1;
+
+                for (int i = 0; i < count; i++)
+                {
+                    if (points[i] == cluster && (best < 0 || (cluster ? energy[i] > energy[best] : energy[i] < energy[best])))
+                    {
+                        best = i;
+                    }
+                }
+
+                return best;
+            };
+
+            std::mt19937 generator(1);
+            int initial = count / 10;
+
+            for (int placed = 0; placed < initial;)
+            {
+                int point = generator() % count;
+
+                if (!points[point])
+                {
+                    update(point, 1.0f);
+                    placed++;
+                }
+            }
+
+            // Move points from the tightest cluster to the largest void until the pattern settles
+            while (true)
+            {
+                int cluster = find(true);
+                update(cluster, -1.0f);
+
+                int gap = find(false);
+                update(gap, 1.0f);
+
+                if (gap == cluster)
+                {
+                    break;
+                }
+            }
+
+            std::vector<int> rank(count);
+            std::vector<char> prototype = points;
+            std::vector<float> prototypeEnergy = energy;
+
+            // Ranks below the initial pattern: remove the tightest clusters one by one
+            for (int r = initial - 1; r >= 0; r--)
+            {
+                int cluster = find(true);
+                update(cluster, -1.0f);
+                rank[cluster] = r;
+            }
+
+            points = prototype;
+            energy = prototypeEnergy;
+
+            // Ranks above it: fill the largest voids one by one
+            for (int r = initial; r < count; r++)
+            {
+                int gap = find(false);
+                update(gap, 1.0f);
+                rank[gap] = r;
+            }
+
+            std::vector<float> table(count);
+
+            for (int i = 0; i < count; i++)
+            {
+                table[i] = (rank[i] + 0.5f) / count - 0.5f;
+            }
+
+            return table;
+        }
+
+        inline const std::vector<float> &blueNoise()
+        {
+            static const std::vector<float> table = makeBlueNoise();
+            return table;
+        }
+    }
+
+    inline float threshold(Pattern pattern, int x, int y)
+    {
+        switch (pattern)
+        {
+        case Pattern::BAYER:
+            return __detail::bayer()[(y & (__detail::BAYER_SIZE - 1)) * __detail::BAYER_SIZE + (x & (__detail::BAYER_SIZE - 1))];
+        case Pattern::BLUE_NOISE:
+            return __detail::blueNoise()[(y & (__detail::NOISE_SIZE - 1)) * __detail::NOISE_SIZE + (x & (__detail::NOISE_SIZE - 1))];
+        case Pattern::NONE:
+        default:
+            return 0.0f;
+        }
+    }
+
+    // Thresholds for a span of `count` pixels starting at (x, y). Entry j belongs to pixel x + j
+    // and the pattern repeats every `period` pixels, so a block of BLOCK pixels starting at span
+    // offset i reads BLOCK consecutive entries from block(i). That keeps fixed-size inner loops
+    // free of index arithmetic and lets them vectorize. Without a pattern block() is null, so
+    // callers can skip the thresholds altogether.
+    class Row
+    {
+    public:
+        static constexpr int BLOCK = 16;
+
+        Row(Pattern pattern, int x, int y, int count)
+        {
+            period = pattern == Pattern::BAYER ? __detail::BAYER_SIZE : pattern == Pattern::BLUE_NOISE ? __detail::NOISE_SIZE
+                                                                                                       : 0;
+
+            int n = period ? std::min(period + BLOCK, count) : 0;
+
+            for (int j = 0; j < n; j++)
+            {
+                values[j] = threshold(pattern, x + j, y);
+            }
+        }
+
+        const float *block(int i) const { return period ? values + i % period : nullptr; }
+
+        float operator[](int i) const { return period ? values[i % period] : 0.0f; }
+
+    private:
+        int period;
+        float values[__detail::NOISE_SIZE + BLOCK];
+    };
+
+    // Truncates value + threshold, clamped to 0..255; values are expected pre-offset by 0.5
+    inline Byte quantize(float value)
+    {
+        return static_cast<int>(std::clamp(value, 0.0f, 255.0f));
+    }
+
+    // Grayscale conversion that keeps the fractional part of the luminance as dithered noise
+    inline GrayscaleImage toGrayscale(const ColorImage &image, Pattern pattern)
+    {
+        int width = image.GetWidth(), height = image.GetHeight();
+
+        GrayscaleImage result(width, height);
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                const RGBA &color = image(x, y);
+
+                result(x, y) = quantize(0.299f * color.r + 0.587f * color.g + 0.114f * color.b + 0.5f + threshold(pattern, x, y));
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,553 @@
+#pragma once
+
+#include "Image.h"
+#include "Parallel.h"
+#include <cmath>
+#include <vector>
+
+namespace filter
+{
+    // How samples outside the image are made up
+    enum class Border
+    {
+        CLAMP = 0, // repeat the edge pixel
+        MIRROR,    // reflect about the edge pixel: 2 1 | 0 1 2
+        WRAP,      // tile the image
+        ZERO
+    };
+
+    // Float samples row by row. Filters produce these, so signed and fractional results such as
+    // derivatives survive until they are turned back into an image.
+    struct Plane
+    {
+        int width = 0, height = 0;
+        std::vector<float> values;
+
+        Plane() = default;
+
+        Plane(int width, int height) : width(width), height(height), values(width * height, 0.0f) {}
+
+        float &operator()(int x, int y) { return values[y * width + x]; }
+
+        float operator()(int x, int y) const { return values[y * width + x]; }
+    };
+
+    // A kernel that is the outer product of a horizontal and a vertical one, applied as one pass
+    // along rows and one along columns: 2r + 1 taps per pass instead of (2r + 1)^2 per pixel
+    struct Separable
+    {
+        std::vector<float> horizontal, vertical;
+
+        static Separable box(int radius)
+        {
+            radius = std::max(radius, 0);
+
+            std::vector<float> taps(2 * radius + 1, 1.0f / (2 * radius + 1));
+            return {taps, taps};
+        }
+
+        // A radius of 0 picks 3 sigma, rounded up
+        static Separable gaussian(float sigma, int radius = 0)
+        {
+            if (sigma <= 0)
+            {
+                return box(0);
+            }
+
+            if (radius <= 0)
+            {
+                radius = static_cast<int>(std::ceil(3 * sigma));
+            }
+
+            std::vector<float> taps(2 * radius + 1);
+            float sum = 0;
+
+            for (int i = -radius; i <= radius; i++)
+            {
+                taps[i + radius] = std::exp(-i * i / (2 * sigma * sigma));
+                sum += taps[i + radius];
+            }
+
+            for (float &tap : taps)
+            {
+                tap /= sum;
+            }
+
+            return {taps, taps};
+        }
+
+        // Unnormalized Sobel derivatives of size 3 or 5, right minus left and down minus up
+        static Separable sobelX(int size = 3)
+        {
+            return {sobelDerivative(size), sobelSmoothing(size)};
+        }
+
+        static Separable sobelY(int size = 3)
+        {
+            return {sobelSmoothing(size), sobelDerivative(size)};
+        }
+
+    private:
+        static std::vector<float> sobelSmoothing(int size)
+        {
+            return size == 5 ? std::vector<float>{1, 4, 6, 4, 1} : std::vector<float>{1, 2, 1};
+        }
+
+        static std::vector<float> sobelDerivative(int size)
+        {
+            return size == 5 ? std::vector<float>{-1, -2, 0, 2, 1} : std::vector<float>{-1, 0, 1};
+        }
+    };
+
+    // A square kernel of odd size, weights row by row. Weights are applied as laid out, without
+    // flipping, so weights[0] meets the pixel up and to the left.
+    struct Kernel
+    {
+        int size = 1;
+        std::vector<float> weights{1.0f};
+
+        Kernel() = default;
+
+        Kernel(int size, std::vector<float> weights)
+        {
+            if (size < 1 || size % 2 == 0 || static_cast<int>(weights.size()) != size * size)
+            {
+                std::cerr << "A kernel needs an odd size and size * size weights." << std::endl;
+                return;
+            }
+
+            this->size = size;
+            this->weights = std::move(weights);
+        }
+
+        // Both passes must have the same length
+        explicit Kernel(const Separable &separable)
+        {
+            int n = separable.horizontal.size();
+
+            if (n % 2 == 0 || static_cast<int>(separable.vertical.size()) != n)
+            {
+                std::cerr << "Only square separable kernels of odd size convert to a Kernel." << std::endl;
+                return;
+            }
+
+            size = n;
+            weights.resize(n * n);
+
+            for (int y = 0; y < n; y++)
+            {
+                for (int x = 0; x < n; x++)
+                {
+                    weights[y * n + x] = separable.vertical[y] * separable.horizontal[x];
+                }
+            }
+        }
+
+        static Kernel box(int size = 3)
+        {
+            return Kernel(Separable::box(size / 2));
+        }
+
+        // A sigma of 0 picks the usual one for the size, 0.3 * ((size - 1) / 2 - 1) + 0.8
+        static Kernel gaussian(int size = 3, float sigma = 0)
+        {
+            if (sigma <= 0)
+            {
+                sigma = 0.3f * ((size - 1) * 0.5f - 1) + 0.8f;
+            }
+
+            return Kernel(Separable::gaussian(sigma, size / 2));
+        }
+
+        static Kernel sobelX(int size = 3) { return Kernel(Separable::sobelX(size)); }
+
+        static Kernel sobelY(int size = 3) { return Kernel(Separable::sobelY(size)); }
+
+        // Sum of second derivatives, size 3 or 5, negative at the center
+        static Kernel laplacian(int size = 3)
+        {
+            if (size == 5)
+            {
+                return Kernel(5, {0, 0, 1, 0, 0,
+                                  0, 1, 2, 1, 0,
+                                  1, 2, -16, 2, 1,
+                                  0, 1, 2, 1, 0,
+                                  0, 0, 1, 0, 0});
+            }
+
+            return Kernel(3, {0, 1, 0,
+                              1, -4, 1,
+                              0, 1, 0});
+        }
+    };
+
+    namespace __detail
+    {
+        constexpr int BLOCK = 8;
+
+        // Index of the sample standing in for index i of n, or -1 for a zero
+        inline int source(int i, int n, Border border)
+        {
+            switch (border)
+            {
+            case Border::ZERO:
+                return i < 0 || i >= n ? -1 : i;
+            case Border::WRAP:
+                return (i % n + n) % n;
+            case Border::MIRROR:
+            {
+                if (n == 1)
+                {
+                    return 0;
+                }
+
+                int period = 2 * n - 2;
+                i = (i % period + period) % period;
+                return i < n ? i : period - i;
+            }
+            case Border::CLAMP:
+            default:
+                return std::clamp(i, 0, n - 1);
+            }
+        }
+
+        // The image with rx columns and ry rows of border on every side. Rows are `pitch` long:
+        // the width rounded up to whole blocks plus both borders, so passes only ever run whole
+        // blocks and never test for the edge. row(y) starts at column -rx of padded row y, where
+        // padded row 0 is image row -ry.
+        struct Padded
+        {
+            int width, height, rx, ry, stride, pitch;
+            std::vector<float> values;
+
+            const float *row(int y) const { return &values[y * pitch]; }
+        };
+
+        template <typename Sample>
+        Padded pad(int width, int height, int rx, int ry, Border border, parallel::Execution execution, Sample sample)
+        {
+            Padded padded;
+            padded.width = width;
+            padded.height = height;
+            padded.rx = rx;
+            padded.ry = ry;
+            padded.stride = (width + BLOCK - 1) / BLOCK * BLOCK;
+            padded.pitch = padded.stride + 2 * rx;
+            padded.values.assign(padded.pitch * (height + 2 * ry), 0.0f);
+
+            std::vector<int> columns(padded.pitch);
+
+            for (int c = 0; c < padded.pitch; c++)
+            {
+                columns[c] = source(c - rx, width, border);
+            }
+
+            parallel::forEach(height + 2 * ry, [&](int begin, int end)
+                              {
+                                  for (int r = begin; r < end; r++)
+                                  {
+                                      int y = source(r - ry, height, border);
+
+                                      if (y < 0)
+                                      {
+                                          continue;
+                                      }
+
+                                      float *row = &padded.values[r * padded.pitch];
+
+                                      for (int c = 0; c < padded.pitch; c++)
+                                      {
+                                          row[c] = columns[c] < 0 ? 0.0f : sample(columns[c], y);
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return padded;
+        }
+
+        // The sums are kept in a local block and copied out after, so stores to the output cannot
+        // alias the inputs and the inner loops vectorize
+        inline Plane convolve(const Padded &padded, const Kernel &kernel, parallel::Execution execution)
+        {
+            int width = padded.width, size = kernel.size;
+
+            Plane result(width, padded.height);
+
+            parallel::forEach(padded.height, [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      for (int x = 0; x < width; x += BLOCK)
+                                      {
+                                          float sum[BLOCK] = {};
+
+                                          for (int ky = 0; ky < size; ky++)
+                                          {
+                                              const float *row = padded.row(y + ky) + x;
+
+                                              for (int kx = 0; kx < size; kx++)
+                                              {
+                                                  float weight = kernel.weights[ky * size + kx];
+
+                                                  for (int j = 0; j < BLOCK; j++)
+                                                  {
+                                                      sum[j] += weight * row[kx + j];
+                                                  }
+                                              }
+                                          }
+
+                                          std::copy_n(sum, std::min(BLOCK, width - x), &result(x, y));
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return result;
+        }
+
+        // Rows first, border rows included, into a block-aligned intermediate; then columns
+        inline Plane convolve(const Padded &padded, const Separable &separable, parallel::Execution execution)
+        {
+            int width = padded.width, height = padded.height, stride = padded.stride;
+            int across = separable.horizontal.size(), down = separable.vertical.size();
+
+            std::vector<float> rows(stride * (height + 2 * padded.ry));
+
+            parallel::forEach(height + 2 * padded.ry, [&](int begin, int end)
+                              {
+                                  for (int r = begin; r < end; r++)
+                                  {
+                                      for (int x = 0; x < stride; x += BLOCK)
+                                      {
+                                          float sum[BLOCK] = {};
+                                          const float *row = padded.row(r) + x;
+
+                                          for (int k = 0; k < across; k++)
+                                          {
+                                              float weight = separable.horizontal[k];
+
+                                              for (int j = 0; j < BLOCK; j++)
+                                              {
+                                                  sum[j] += weight * row[k + j];
+                                              }
+                                          }
+
+                                          std::copy_n(sum, BLOCK, &rows[r * stride + x]);
+                                      }
+                                  }
+                              },
+                              execution);
+
+            Plane result(width, height);
+
+            parallel::forEach(height, [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      for (int x = 0; x < width; x += BLOCK)
+                                      {
+                                          float sum[BLOCK] = {};
+
+                                          for (int k = 0; k < down; k++)
+                                          {
+                                              float weight = separable.vertical[k];
+                                              const float *row = &rows[(y + k) * stride + x];
+
+                                              for (int j = 0; j < BLOCK; j++)
+                                              {
+                                                  sum[j] += weight * row[j];
+                                              }
+                                          }
+
+                                          std::copy_n(sum, std::min(BLOCK, width - x), &result(x, y));
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return result;
+        }
+
+        inline int radius(const Kernel &kernel) { return kernel.size / 2; }
+
+        inline int radiusX(const Separable &separable) { return separable.horizontal.size() / 2; }
+
+        inline int radiusY(const Separable &separable) { return separable.vertical.size() / 2; }
+
+        inline bool valid(const Separable &separable)
+        {
+            if (separable.horizontal.size() % 2 == 0 || separable.vertical.size() % 2 == 0)
+            {
+                std::cerr << "Separable kernels need an odd number of taps in each pass." << std::endl;
+                return false;
+            }
+
+            return true;
+        }
+
+        template <typename Sample>
+        Plane convolve(int width, int height, const Kernel &kernel, Border border, parallel::Execution execution, Sample sample)
+        {
+            if (width <= 0 || height <= 0)
+            {
+                return Plane();
+            }
+
+            int r = radius(kernel);
+            return convolve(pad(width, height, r, r, border, execution, sample), kernel, execution);
+        }
+
+        template <typename Sample>
+        Plane convolve(int width, int height, const Separable &separable, Border border, parallel::Execution execution, Sample sample)
+        {
+            if (width <= 0 || height <= 0 || !valid(separable))
+            {
+                return Plane();
+            }
+
+            return convolve(pad(width, height, radiusX(separable), radiusY(separable), border, execution, sample), separable, execution);
+        }
+
+        inline Byte toByte(float value)
+        {
+            return static_cast<int>(std::min(std::max(value + 0.5f, 0.0f), 255.0f));
+        }
+
+        template <typename Filter>
+        ColorImage filterChannels(const ColorImage &image, const Filter &filter, Border border, parallel::Execution execution)
+        {
+            int width = image.GetWidth(), height = image.GetHeight();
+
+            auto channel = [&](Byte RGBA::*member)
+            {
+                return convolve(width, height, filter, border, execution, [&](int x, int y)
+                                { return static_cast<float>(image(x, y).*member); });
+            };
+
+            Plane r = channel(&RGBA::r), g = channel(&RGBA::g), b = channel(&RGBA::b), a = channel(&RGBA::a);
+
+            ColorImage result(width, height);
+
+            parallel::forEach(height, [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      for (int x = 0; x < width; x++)
+                                      {
+                                          result(x, y) = RGBA(toByte(r(x, y)), toByte(g(x, y)), toByte(b(x, y)), toByte(a(x, y)));
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return result;
+        }
+    }
+
+    inline Plane toPlane(const GrayscaleImage &image)
+    {
+        Plane plane(image.GetWidth(), image.GetHeight());
+
+        for (int y = 0; y < plane.height; y++)
+        {
+            for (int x = 0; x < plane.width; x++)
+            {
+                plane(x, y) = image(x, y);
+            }
+        }
+
+        return plane;
+    }
+
+    // value * scale + offset, rounded and clamped to 0..255. An offset of 128 shows signed
+    // results such as derivatives or a Laplacian with zero as mid gray.
+    inline GrayscaleImage toImage(const Plane &plane, float scale = 1.0f, float offset = 0.0f, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        GrayscaleImage image(plane.width, plane.height);
+
+        parallel::forEach(plane.height, [&](int begin, int end)
+                          {
+                              for (int y = begin; y < end; y++)
+                              {
+                                  for (int x = 0; x < plane.width; x++)
+                                  {
+                                      image(x, y) = __detail::toByte(plane(x, y) * scale + offset);
+                                  }
+                              }
+                          },
+                          execution);
+
+        return image;
+    }
+
+    inline Plane convolve(const Plane &plane, const Kernel &kernel, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::convolve(plane.width, plane.height, kernel, border, execution, [&](int x, int y)
+                                  { return plane(x, y); });
+    }
+
+    inline Plane convolve(const Plane &plane, const Separable &separable, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::convolve(plane.width, plane.height, separable, border, execution, [&](int x, int y)
+                                  { return plane(x, y); });
+    }
+
+    inline Plane convolve(const GrayscaleImage &image, const Kernel &kernel, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::convolve(image.GetWidth(), image.GetHeight(), kernel, border, execution, [&](int x, int y)
+                                  { return static_cast<float>(image(x, y)); });
+    }
+
+    inline Plane convolve(const GrayscaleImage &image, const Separable &separable, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::convolve(image.GetWidth(), image.GetHeight(), separable, border, execution, [&](int x, int y)
+                                  { return static_cast<float>(image(x, y)); });
+    }
+
+    // Filtered images, rounded and clamped back to 8 bits
+    inline GrayscaleImage filter(const GrayscaleImage &image, const Kernel &kernel, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return toImage(convolve(image, kernel, border, execution), 1.0f, 0.0f, execution);
+    }
+
+    inline GrayscaleImage filter(const GrayscaleImage &image, const Separable &separable, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return toImage(convolve(image, separable, border, execution), 1.0f, 0.0f, execution);
+    }
+
+    // All four channels are filtered, alpha included
+    inline ColorImage filter(const ColorImage &image, const Kernel &kernel, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::filterChannels(image, kernel, border, execution);
+    }
+
+    inline ColorImage filter(const ColorImage &image, const Separable &separable, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::filterChannels(image, separable, border, execution);
+    }
+
+    struct Derivatives
+    {
+        Plane dx, dy;
+    };
+
+    // Horizontal and vertical Sobel derivatives, each sharing one padded copy of the image
+    inline Derivatives sobel(const GrayscaleImage &image, int size = 3, Border border = Border::CLAMP, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        int width = image.GetWidth(), height = image.GetHeight();
+
+        if (width <= 0 || height <= 0)
+        {
+            return Derivatives();
+        }
+
+        Separable sobelX = Separable::sobelX(size), sobelY = Separable::sobelY(size);
+        int r = __detail::radiusX(sobelX);
+
+        __detail::Padded padded = __detail::pad(width, height, r, r, border, execution, [&](int x, int y)
+                                                { return static_cast<float>(image(x, y)); });
+
+        return {__detail::convolve(padded, sobelX, execution), __detail::convolve(padded, sobelY, execution)};
+    }
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Image.h"
+#include "Color.h"
+#include "Dither.h"
+#include "Parallel.h"
+#include <array>
 #include <optional>
 
 #ifndef POINT
@@ -37,6 +41,37 @@ namespace gradient
             float getAngle() const { return angleDegrees; }
         };
 
+        // Writes BLOCK pixels of value + (first + k) * step + thresholds[k], truncated and capped at
+        // 255. The thresholds are copied locally first: a Byte store could alias them otherwise,
+        // which keeps the compiler from vectorizing the loop.
+        inline void rampBlock(Byte *out, float value, float step, int first, const float *thresholds)
+        {
+            constexpr int BLOCK = dither::Row::BLOCK;
+
+            // Undithered values stay below 255.5 and need no cap
+            if (!thresholds)
+            {
+                for (int k = 0; k < BLOCK; k++)
+                {
+                    out[k] = static_cast<int>(value + (first + k) * step);
+                }
+                return;
+            }
+
+            float threshold[BLOCK];
+            std::copy_n(thresholds, BLOCK, threshold);
+
+            for (int k = 0; k < BLOCK; k++)
+            {
+                out[k] = std::min(static_cast<int>(value + (first + k) * step + threshold[k]), 255);
+            }
+        }
+
+        inline Byte rampPixel(float value, float step, int i, float threshold)
+        {
+            return std::min(static_cast<int>(value + i * step + threshold), 255);
+        }
+
         // Base gradient class using CRTP for common functionality
         template <typename Derived, typename ColorType>
         class GradientBase
@@ -51,9 +86,22 @@ namespace gradient
             float maxProjection = 1.0f;
             bool projectionReady = false;
 
+            // Unit vector of the direction, computed once instead of per pixel
+            float dirX = 1.0f, dirY = 0.0f;
+
+            dither::Pattern ditherPattern = dither::Pattern::NONE;
+
         public:
             GradientBase(ColorType start, ColorType end, std::optional<Direction> dir = std::nullopt)
-                : startColor(start), endColor(end), direction(dir) {}
+                : startColor(start), endColor(end), direction(dir)
+            {
+                if (direction.has_value())
+                {
+                    float angle_rad = direction->getAngle() * M_PI / 180.0f;
+                    dirX = cos(angle_rad);
+                    dirY = sin(angle_rad);
+                }
+            }
 
             ColorType at(int x, int y) const
             {
@@ -79,49 +127,126 @@ namespace gradient
                 return static_cast<const Derived *>(this)->interpolate(startColor, endColor, t);
             }
 
+            // Dithers the span functions below, so large smooth gradients do not band. at() and
+            // next() stay undithered.
+            void setDither(dither::Pattern pattern) { ditherPattern = pattern; }
+
+            // Span versions of at() and next(): `count` pixels starting at (x, y), or at sequence
+            // index currentStep. Along a row both the projection and the sequence position change
+            // by a constant per pixel, so only the first one is computed and the rest are stepped.
+            template <typename Pixel>
+            void atSpan(Pixel *out, int x, int y, int count) const
+            {
+                dither::Row thresholds(ditherPattern, x, y, count);
+
+                if (!direction.has_value() || maxProjection == minProjection)
+                {
+                    interpolateSpan(out, count, direction.has_value() ? 0.5f : 0.0f, 0.0f, thresholds);
+                    return;
+                }
+
+                float range = maxProjection - minProjection;
+
+                interpolateSpan(out, count, (calculateProjection(x, y) - minProjection) / range, dirX / range, thresholds);
+            }
+
+            // (x, y) is where the span lands in the image, which only matters when dithering
+            template <typename Pixel>
+            void nextSpan(Pixel *out, int totalSteps, int currentStep, int count, int x = 0, int y = 0) const
+            {
+                dither::Row thresholds(ditherPattern, x, y, count);
+
+                if (direction.has_value() || totalSteps <= 1)
+                {
+                    interpolateSpan(out, count, 0.0f, 0.0f, thresholds);
+                    return;
+                }
+
+                float step = 1.0f / (totalSteps - 1);
+
+                interpolateSpan(out, count, currentStep * step, step, thresholds);
+            }
+
+            // Positions outside [0, 1] clamp to the end colors. The run in between is found up front
+            // so the interpolation loop itself needs no clamping.
+            template <typename Pixel>
+            void interpolateSpan(Pixel *out, int count, float t, float dt, const dither::Row &thresholds) const
+            {
+                const Derived &gradient = *static_cast<const Derived *>(this);
+
+                int first = count, last = count;
+
+                if (dt == 0.0f)
+                {
+                    if (t >= 0.0f && t <= 1.0f)
+                    {
+                        first = 0;
+                    }
+                }
+                else
+                {
+                    float from = -t / dt, to = (1.0f - t) / dt;
+
+                    first = std::clamp(std::ceil(std::min(from, to)), 0.0f, float(count));
+                    last = std::clamp(std::floor(std::max(from, to)) + 1.0f, float(first), float(count));
+                }
+
+                std::fill_n(out, first, gradient.pixel(t));
+                gradient.interpolateRun(out + first, last - first, t + first * dt, dt, thresholds, first);
+                std::fill_n(out + last, count - last, gradient.pixel(t + (count - 1) * dt));
+            }
+
             bool isDirectional() const { return direction.has_value(); }
 
-            void prepareDirectional(const Point &polygonCenter,
-                                    const std::vector<std::pair<Point, Point>> &fillLines)
+            // The projection is linear, so its range over a polygon is reached at the vertices
+            void prepareDirectional(const Point &polygonCenter, const std::vector<Point> &vertices)
             {
                 if (!direction.has_value())
                     return;
 
                 center = polygonCenter;
 
-                float angle_rad = direction->getAngle() * M_PI / 180.0f;
-                float dir_x = cos(angle_rad);
-                float dir_y = sin(angle_rad);
-
                 minProjection = std::numeric_limits<float>::max();
                 maxProjection = std::numeric_limits<float>::lowest();
 
-                for (const auto &[start, end] : fillLines)
+                for (const Point &vertex : vertices)
                 {
-                    for (int x = start.x; x <= end.x; x++)
-                    {
-                        float vec_x = x - center.x;
-                        float vec_y = start.y - center.y;
-                        float projection = vec_x * dir_x + vec_y * dir_y;
+                    float projection = calculateProjection(vertex.x, vertex.y);
 
-                        minProjection = std::min(minProjection, projection);
-                        maxProjection = std::max(maxProjection, projection);
-                    }
+                    minProjection = std::min(minProjection, projection);
+                    maxProjection = std::max(maxProjection, projection);
                 }
 
                 projectionReady = true;
             }
 
-        private:
-            float calculateNormalizedPosition(int x, int y) const
+            // Range over the pixels of the given spans; only their ends can be extremes
+            void prepareDirectional(const Point &polygonCenter,
+                                    const std::vector<std::pair<Point, Point>> &fillLines)
             {
-                float angle_rad = direction->getAngle() * M_PI / 180.0f;
-                float dir_x = cos(angle_rad);
-                float dir_y = sin(angle_rad);
+                std::vector<Point> ends;
+                ends.reserve(2 * fillLines.size());
+
+                for (const auto &[start, end] : fillLines)
+                {
+                    ends.push_back(start);
+                    ends.push_back({end.x, start.y});
+                }
 
+                prepareDirectional(polygonCenter, ends);
+            }
+
+        private:
+            float calculateProjection(int x, int y) const
+            {
                 float vec_x = x - center.x;
                 float vec_y = y - center.y;
-                float projection = vec_x * dir_x + vec_y * dir_y;
+                return vec_x * dirX + vec_y * dirY;
+            }
+
+            float calculateNormalizedPosition(int x, int y) const
+            {
+                float projection = calculateProjection(x, y);
 
                 if (maxProjection == minProjection)
                     return 0.5f;
@@ -171,6 +296,40 @@ namespace gradient
         {
             return static_cast<Byte>(std::round(GradientBase::at(x, y)));
         }
+
+        Byte pixel(float t) const
+        {
+            return static_cast<Byte>(std::round(interpolate(startColor, endColor, std::clamp(t, 0.0f, 1.0f))));
+        }
+
+        // Pixel i gets position t + i * dt, all within [0, 1], and threshold offset + i. The
+        // fixed-size blocks are loops the compiler vectorizes at -O2.
+        void interpolateRun(Byte *out, int count, float t, float dt, const dither::Row &thresholds, int offset) const
+        {
+            if (std::min(startColor, endColor) < 0.0f || std::max(startColor, endColor) > 255.0f)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    out[i] = dither::quantize(interpolate(startColor, endColor, t + i * dt) + 0.5f + thresholds[offset + i]);
+                }
+                return;
+            }
+
+            float value = startColor + t * (endColor - startColor) + 0.5f;
+            float step = dt * (endColor - startColor);
+
+            int i = 0;
+
+            for (; i + dither::Row::BLOCK <= count; i += dither::Row::BLOCK)
+            {
+                __detail::rampBlock(out + i, value, step, i, thresholds.block(offset + i));
+            }
+
+            for (; i < count; i++)
+            {
+                out[i] = __detail::rampPixel(value, step, i, thresholds[offset + i]);
+            }
+        }
     };
 
     struct RGBGradient : public __detail::GradientBase<RGBGradient, RGBA>
@@ -214,5 +373,346 @@ namespace gradient
         {
             return GradientBase::at(x, y);
         }
+
+        RGBA pixel(float t) const
+        {
+            return interpolate(startColor, endColor, std::clamp(t, 0.0f, 1.0f));
+        }
+
+        // Each block is ramped one channel at a time and then interleaved
+        void interpolateRun(RGBA *out, int count, float t, float dt, const dither::Row &thresholds, int offset) const
+        {
+            constexpr int BLOCK = dither::Row::BLOCK;
+
+            float r = startColor.r + t * (endColor.r - startColor.r) + 0.5f, dr = dt * (endColor.r - startColor.r);
+            float g = startColor.g + t * (endColor.g - startColor.g) + 0.5f, dg = dt * (endColor.g - startColor.g);
+            float b = startColor.b + t * (endColor.b - startColor.b) + 0.5f, db = dt * (endColor.b - startColor.b);
+
+            int i = 0;
+
+            for (; i + BLOCK <= count; i += BLOCK)
+            {
+                Byte red[BLOCK], green[BLOCK], blue[BLOCK];
+                const float *threshold = thresholds.block(offset + i);
+
+                __detail::rampBlock(red, r, dr, i, threshold);
+                __detail::rampBlock(green, g, dg, i, threshold);
+                __detail::rampBlock(blue, b, db, i, threshold);
+
+                for (int k = 0; k < BLOCK; k++)
+                {
+                    out[i + k] = RGBA(red[k], green[k], blue[k]);
+                }
+            }
+
+            for (; i < count; i++)
+            {
+                float threshold = thresholds[offset + i];
+
+                out[i] = RGBA(__detail::rampPixel(r, dr, i, threshold), __detail::rampPixel(g, dg, i, threshold), __detail::rampPixel(b, db, i, threshold));
+            }
+        }
+    };
+
+    namespace __detail
+    {
+        // Where a pixel falls on a stop gradient, before clamping to [0, 1]
+        struct Geometry
+        {
+            enum class Shape
+            {
+                Linear,
+                Radial,
+                Conic,
+                Diamond
+            };
+
+            Shape shape;
+            float x, y;
+            // Linear: direction divided by its squared length. Radial and diamond: 1 / radius in dx.
+            // Conic: start angle in radians in dx.
+            float dx, dy;
+
+            float position(float px, float py) const
+            {
+                float vx = px - x, vy = py - y;
+
+                switch (shape)
+                {
+                case Shape::Linear:
+                    return vx * dx + vy * dy;
+                case Shape::Radial:
+                    return std::sqrt(vx * vx + vy * vy) * dx;
+                case Shape::Diamond:
+                    return (std::abs(vx) + std::abs(vy)) * dx;
+                case Shape::Conic:
+                default:
+                {
+                    float turn = (std::atan2(vy, vx) - dx) / float(2 * M_PI);
+                    return turn - std::floor(turn);
+                }
+                }
+            }
+        };
+
+        // Gradient through any number of color stops, baked into a Size-entry table when it is
+        // built, so a pixel costs its position plus one table fetch. Positions outside [0, 1] pad
+        // with the end colors.
+        template <typename Derived, typename Pixel, typename ColorType, int Size>
+        class StopGradientBase
+        {
+        public:
+            using Stops = std::vector<std::pair<float, ColorType>>;
+
+            Pixel at(int x, int y) const
+            {
+                return table[index(geometry.position(x, y))];
+            }
+
+            // `count` pixels of row y starting at x. Linear gradients step the table index by a
+            // constant per pixel; the other shapes evaluate their position per pixel.
+            void atSpan(Pixel *out, int x, int y, int count) const
+            {
+                if (geometry.shape == Geometry::Shape::Linear)
+                {
+                    float first = geometry.position(x, y) * (Size - 1) + 0.5f;
+                    float step = geometry.dx * (Size - 1);
+
+                    for (int i = 0; i < count; i++)
+                    {
+                        out[i] = table[static_cast<int>(std::clamp(first + i * step, 0.0f, float(Size - 1)))];
+                    }
+                }
+                else
+                {
+                    for (int i = 0; i < count; i++)
+                    {
+                        out[i] = table[index(geometry.position(x + i, y))];
+                    }
+                }
+            }
+
+        protected:
+            Geometry geometry;
+            std::array<Pixel, Size> table;
+
+            StopGradientBase(Geometry geometry, Stops stops) : StopGradientBase(geometry, std::move(stops), Derived::mix) {}
+
+            // mix(from, to, t) fills the table between neighbouring stops
+            template <typename Mix>
+            StopGradientBase(Geometry geometry, Stops stops, Mix mix) : geometry(geometry)
+            {
+                std::stable_sort(stops.begin(), stops.end(), [](const auto &a, const auto &b)
+                                 { return a.first < b.first; });
+
+                int stop = 0;
+
+                for (int i = 0; i < Size; i++)
+                {
+                    float t = float(i) / (Size - 1);
+
+                    if (stops.empty())
+                    {
+                        table[i] = Pixel();
+                        continue;
+                    }
+
+                    while (stop + 1 < (int)stops.size() && stops[stop + 1].first <= t)
+                    {
+                        stop++;
+                    }
+
+                    if (t <= stops.front().first)
+                    {
+                        table[i] = mix(stops.front().second, stops.front().second, 0.0f);
+                    }
+                    else if (stop + 1 == (int)stops.size())
+                    {
+                        table[i] = mix(stops.back().second, stops.back().second, 0.0f);
+                    }
+                    else
+                    {
+                        const auto &[from, fromColor] = stops[stop];
+                        const auto &[to, toColor] = stops[stop + 1];
+
+                        table[i] = mix(fromColor, toColor, (t - from) / (to - from));
+                    }
+                }
+            }
+
+            static Geometry linear(Point start, Point end)
+            {
+                float dx = end.x - start.x, dy = end.y - start.y;
+                float length = dx * dx + dy * dy;
+
+                if (length == 0)
+                {
+                    return {Geometry::Shape::Linear, float(start.x), float(start.y), 0.0f, 0.0f};
+                }
+
+                return {Geometry::Shape::Linear, float(start.x), float(start.y), dx / length, dy / length};
+            }
+
+            static Geometry radial(Point center, float radius, Geometry::Shape shape = Geometry::Shape::Radial)
+            {
+                return {shape, float(center.x), float(center.y), radius > 0 ? 1.0f / radius : 0.0f, 0.0f};
+            }
+
+            static Geometry conic(Point center, float degrees)
+            {
+                return {Geometry::Shape::Conic, float(center.x), float(center.y), degrees * float(M_PI) / 180.0f, 0.0f};
+            }
+
+        private:
+            static int index(float t)
+            {
+                return static_cast<int>(std::clamp(t * (Size - 1) + 0.5f, 0.0f, float(Size - 1)));
+            }
+        };
+    }
+
+    // Multi-stop gradients in image coordinates: linear from start to end, radial and diamond
+    // from the center out to radius, conic sweeping once around the center from `degrees`
+    struct StopGradient : public __detail::StopGradientBase<StopGradient, Byte, float, 256>
+    {
+        static StopGradient Linear(Point start, Point end, Stops stops)
+        {
+            return StopGradient(linear(start, end), std::move(stops));
+        }
+
+        static StopGradient Radial(Point center, float radius, Stops stops)
+        {
+            return StopGradient(radial(center, radius), std::move(stops));
+        }
+
+        static StopGradient Diamond(Point center, float radius, Stops stops)
+        {
+            return StopGradient(radial(center, radius, __detail::Geometry::Shape::Diamond), std::move(stops));
+        }
+
+        static StopGradient Conic(Point center, float degrees, Stops stops)
+        {
+            return StopGradient(conic(center, degrees), std::move(stops));
+        }
+
+        static Byte mix(float from, float to, float t)
+        {
+            return static_cast<Byte>(std::round(std::clamp(from + t * (to - from), 0.0f, 255.0f)));
+        }
+
+    private:
+        using StopGradientBase::StopGradientBase;
+    };
+
+    namespace __detail
+    {
+        struct SpaceMix
+        {
+            color::Space space;
+
+            RGBA operator()(RGBA from, RGBA to, float t) const { return color::mix(from, to, t, space); }
+        };
+    }
+
+    // RGB stops get a larger table, since each channel ramps on its own. The stops can be
+    // interpolated in linear light or a perceptual space instead of on the sRGB bytes; the
+    // conversion happens while the table is built, so rendering costs the same either way.
+    struct RGBStopGradient : public __detail::StopGradientBase<RGBStopGradient, RGBA, RGBA, 1024>
+    {
+        static RGBStopGradient Linear(Point start, Point end, Stops stops, color::Space space = color::Space::SRGB)
+        {
+            return RGBStopGradient(linear(start, end), std::move(stops), __detail::SpaceMix{space});
+        }
+
+        static RGBStopGradient Radial(Point center, float radius, Stops stops, color::Space space = color::Space::SRGB)
+        {
+            return RGBStopGradient(radial(center, radius), std::move(stops), __detail::SpaceMix{space});
+        }
+
+        static RGBStopGradient Diamond(Point center, float radius, Stops stops, color::Space space = color::Space::SRGB)
+        {
+            return RGBStopGradient(radial(center, radius, __detail::Geometry::Shape::Diamond), std::move(stops), __detail::SpaceMix{space});
+        }
+
+        static RGBStopGradient Conic(Point center, float degrees, Stops stops, color::Space space = color::Space::SRGB)
+        {
+            return RGBStopGradient(conic(center, degrees), std::move(stops), __detail::SpaceMix{space});
+        }
+
+        static RGBA mix(RGBA from, RGBA to, float t)
+        {
+            return color::mix(from, to, t, color::Space::SRGB);
+        }
+
+    private:
+        using StopGradientBase::StopGradientBase;
     };
+
+    namespace __detail
+    {
+        // Hands every row of the image to fillRow(row, y, width), split over threads under PARALLEL
+        template <typename Image, typename FillRow>
+        void fillRows(Image &image, parallel::Execution execution, FillRow fillRow)
+        {
+            int width = image.GetWidth();
+
+            if (width <= 0)
+            {
+                return;
+            }
+
+            parallel::forEach(image.GetHeight(), [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      fillRow(&image(0, y), y, width);
+                                  }
+                              },
+                              execution);
+        }
+
+        // Directional gradients span the whole image; sequential ones run once through it in
+        // row-major order
+        template <typename Image, typename Gradient>
+        void fillGradient(Image &image, Gradient gradient, parallel::Execution execution)
+        {
+            int width = image.GetWidth(), height = image.GetHeight();
+
+            if (gradient.isDirectional())
+            {
+                gradient.prepareDirectional({width / 2, height / 2}, {{0, 0}, {width - 1, 0}, {0, height - 1}, {width - 1, height - 1}});
+
+                fillRows(image, execution, [&](auto *row, int y, int width)
+                         { gradient.atSpan(row, 0, y, width); });
+            }
+            else
+            {
+                fillRows(image, execution, [&](auto *row, int y, int width)
+                         { gradient.nextSpan(row, width * height, y * width, width, 0, y); });
+            }
+        }
+    }
+
+    // ========== Whole-image fills ==========
+    inline void fillGradient(GrayscaleImage &image, const Gradient &gradient, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillGradient(image, gradient, execution);
+    }
+
+    inline void fillGradient(ColorImage &image, const RGBGradient &gradient, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillGradient(image, gradient, execution);
+    }
+
+    inline void fillGradient(GrayscaleImage &image, const StopGradient &gradient, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillRows(image, execution, [&](Byte *row, int y, int width)
+                           { gradient.atSpan(row, 0, y, width); });
+    }
+
+    inline void fillGradient(ColorImage &image, const RGBStopGradient &gradient, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillRows(image, execution, [&](RGBA *row, int y, int width)
+                           { gradient.atSpan(row, 0, y, width); });
+    }
 }
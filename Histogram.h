@@ -0,0 +1,684 @@
+#pragma once
+
+#include "Image.h"
+#include "Parallel.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace histogram
+{
+    using Counts = std::array<int, 256>;
+
+    struct ChannelCounts
+    {
+        Counts r, g, b, a;
+    };
+
+    enum class Channel
+    {
+        RED = 0,
+        GREEN,
+        BLUE,
+        ALPHA
+    };
+
+    // Pairs of values counted on a bins x bins grid, the first value picking the row. Levels map
+    // to bin level * bins / 256.
+    struct Joint
+    {
+        int bins = 0;
+        std::vector<int> counts;
+
+        int operator()(int first, int second) const { return counts[first * bins + second]; }
+    };
+
+    namespace __detail
+    {
+        // Private histograms per band. Runs of equal neighbouring pixels are common, and counting
+        // them into different copies keeps each increment from waiting on the store before it.
+        constexpr int COPIES = 4;
+        constexpr int BLOCK = 16;
+
+        // Runs tally(y_begin, y_end, counts) over bands of rows, one band per thread, each with
+        // `copies` zeroed histograms of `size` bins at counts + copy * size. Returns their sum.
+        template <typename Tally>
+        std::vector<int> countBands(int rows, int size, int copies, parallel::Execution execution, Tally tally)
+        {
+            int bands = execution == parallel::Execution::SERIAL ? 1 : std::max(1, std::min(parallel::threadCount(), rows));
+
+            std::vector<std::vector<int>> partial(bands, std::vector<int>(copies * size, 0));
+
+            parallel::forEach(bands, [&](int begin, int end)
+                              {
+                                  for (int band = begin; band < end; band++)
+                                  {
+                                      tally(int((long long)rows * band / bands), int((long long)rows * (band + 1) / bands), partial[band].data());
+                                  }
+                              },
+                              execution);
+
+            std::vector<int> total(size, 0);
+
+            for (const std::vector<int> &counts : partial)
+            {
+                for (int copy = 0; copy < copies; copy++)
+                {
+                    for (int bin = 0; bin < size; bin++)
+                    {
+                        total[bin] += counts[copy * size + bin];
+                    }
+                }
+            }
+
+            return total;
+        }
+
+        // Counts bin(i) for i in [0, count), spreading neighbours over the COPIES histograms. Each
+        // group of four is read before any of it is counted: a byte load may alias the int
+        // counts, so the compiler will not move later loads ahead of the increments itself.
+        template <typename Bin>
+        void tally(int count, int *counts, int size, Bin bin)
+        {
+            static_assert(COPIES == 4, "tally counts four pixels at a time");
+
+            int i = 0;
+
+            for (; i + COPIES <= count; i += COPIES)
+            {
+                int first = bin(i), second = bin(i + 1), third = bin(i + 2), fourth = bin(i + 3);
+
+                counts[first]++;
+                counts[size + second]++;
+                counts[2 * size + third]++;
+                counts[3 * size + fourth]++;
+            }
+
+            for (; i < count; i++)
+            {
+                counts[bin(i)]++;
+            }
+        }
+
+        inline Counts toCounts(const std::vector<int> &total, int offset = 0)
+        {
+            Counts counts;
+            std::copy_n(total.begin() + offset, 256, counts.begin());
+            return counts;
+        }
+
+        inline Byte channel(RGBA pixel, Channel channel)
+        {
+            switch (channel)
+            {
+            case Channel::GREEN:
+                return pixel.g;
+            case Channel::BLUE:
+                return pixel.b;
+            case Channel::ALPHA:
+                return pixel.a;
+            case Channel::RED:
+            default:
+                return pixel.r;
+            }
+        }
+
+        inline int checkBins(int bins)
+        {
+            if (bins < 1 || bins > 256)
+            {
+                std::cerr << "Histogram bins must be between 1 and 256." << std::endl;
+                return std::clamp(bins, 1, 256);
+            }
+
+            return bins;
+        }
+
+        template <typename Pair>
+        Joint countJoint(int width, int height, int bins, parallel::Execution execution, Pair pair)
+        {
+            std::array<int, 256> binOf;
+
+            for (int level = 0; level < 256; level++)
+            {
+                binOf[level] = level * bins / 256;
+            }
+
+            Joint joint;
+            joint.bins = bins;
+
+            // A single copy: a 256 x 256 grid is already larger than the cache lines it would save
+            joint.counts = countBands(height, bins * bins, 1, execution, [&](int begin, int end, int *counts)
+                                      {
+                                          for (int y = begin; y < end; y++)
+                                          {
+                                              for (int x = 0; x < width; x++)
+                                              {
+                                                  auto [first, second] = pair(x, y);
+                                                  counts[binOf[first] * bins + binOf[second]]++;
+                                              }
+                                          }
+                                      });
+
+            return joint;
+        }
+    }
+
+    inline Counts count(const GrayscaleImage &image, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        int width = image.GetWidth();
+
+        auto total = __detail::countBands(image.GetHeight(), 256, __detail::COPIES, execution, [&](int begin, int end, int *counts)
+                                          {
+                                              for (int y = begin; y < end; y++)
+                                              {
+                                                  __detail::tally(width, counts, 256, [&](int x)
+                                                                  { return image(x, y); });
+                                              }
+                                          });
+
+        return __detail::toCounts(total);
+    }
+
+    // All four channels in one pass
+    inline ChannelCounts channels(const ColorImage &image, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        int width = image.GetWidth();
+
+        auto total = __detail::countBands(image.GetHeight(), 4 * 256, __detail::COPIES, execution, [&](int begin, int end, int *counts)
+                                          {
+                                              auto add = [](int *copy, RGBA pixel)
+                                              {
+                                                  copy[pixel.r]++;
+                                                  copy[256 + pixel.g]++;
+                                                  copy[512 + pixel.b]++;
+                                                  copy[768 + pixel.a]++;
+                                              };
+
+                                              for (int y = begin; y < end; y++)
+                                              {
+                                                  int x = 0;
+
+                                                  for (; x + __detail::COPIES <= width; x += __detail::COPIES)
+                                                  {
+                                                      RGBA first = image(x, y), second = image(x + 1, y), third = image(x + 2, y), fourth = image(x + 3, y);
+
+                                                      add(counts, first);
+                                                      add(counts + 1024, second);
+                                                      add(counts + 2048, third);
+                                                      add(counts + 3072, fourth);
+                                                  }
+
+                                                  for (; x < width; x++)
+                                                  {
+                                                      add(counts, image(x, y));
+                                                  }
+                                              }
+                                          });
+
+        return {__detail::toCounts(total, 0), __detail::toCounts(total, 256), __detail::toCounts(total, 512), __detail::toCounts(total, 768)};
+    }
+
+    // Counts of the luma the GrayscaleImage constructor would give, without building the image
+    inline Counts luminance(const ColorImage &image, luma::Weights weights = luma::Weights::REC601, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        int width = image.GetWidth();
+
+        auto total = __detail::countBands(image.GetHeight(), 256, __detail::COPIES, execution, [&](int begin, int end, int *counts)
+                                          {
+                                              RGBA pixels[__detail::BLOCK];
+                                              Byte levels[__detail::BLOCK];
+
+                                              for (int y = begin; y < end; y++)
+                                              {
+                                                  for (int x = 0; x < width; x += __detail::BLOCK)
+                                                  {
+                                                      int n = std::min(__detail::BLOCK, width - x);
+
+                                                      for (int j = 0; j < n; j++)
+                                                      {
+                                                          pixels[j] = image(x + j, y);
+                                                      }
+
+                                                      luma::toGray(pixels, levels, n, weights);
+
+                                                      __detail::tally(n, counts, 256, [&](int j)
+                                                                      { return levels[j]; });
+                                                  }
+                                              }
+                                          });
+
+        return __detail::toCounts(total);
+    }
+
+    // Joint histogram of two images of the same size, pixel by pixel
+    inline Joint joint(const GrayscaleImage &first, const GrayscaleImage &second, int bins = 256, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        if (first.GetWidth() != second.GetWidth() || first.GetHeight() != second.GetHeight())
+        {
+            std::cerr << "Both images must have the same width and height" << std::endl;
+            return Joint();
+        }
+
+        return __detail::countJoint(first.GetWidth(), first.GetHeight(), __detail::checkBins(bins), execution, [&](int x, int y)
+                                    { return std::pair<Byte, Byte>(first(x, y), second(x, y)); });
+    }
+
+    // Joint histogram of two channels of one image
+    inline Joint joint(const ColorImage &image, Channel first, Channel second, int bins = 256, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        return __detail::countJoint(image.GetWidth(), image.GetHeight(), __detail::checkBins(bins), execution, [&](int x, int y)
+                                    {
+                                        RGBA pixel = image(x, y);
+                                        return std::pair<Byte, Byte>(__detail::channel(pixel, first), __detail::channel(pixel, second));
+                                    });
+    }
+
+    // Bars 512 pixels tall, count * scale high, one column per level. Filled a row at a time.
+    inline GrayscaleImage render(const Counts &counts, double scale = 0.05)
+    {
+        GrayscaleImage image(256, 512);
+
+        std::array<int, 256> heights;
+
+        for (int x = 0; x < 256; x++)
+        {
+            heights[x] = std::min<int>(512, counts[x] * scale);
+        }
+
+        for (int y = 0; y < 512; y++)
+        {
+            for (int x = 0; x < 256; x++)
+            {
+                image(x, y) = heights[x] > 511 - y ? 255 : 0;
+            }
+        }
+
+        return image;
+    }
+
+    // Red, green and blue bars side by side, 768 columns in all; alpha is not drawn
+    inline ColorImage render(const ChannelCounts &counts, double scale = 0.05)
+    {
+        ColorImage image(768, 512);
+
+        GrayscaleImage bars[3] = {render(counts.r, scale), render(counts.g, scale), render(counts.b, scale)};
+
+        for (int y = 0; y < 512; y++)
+        {
+            for (int x = 0; x < 256; x++)
+            {
+                image(x, y) = RGBA(bars[0](x, y), 0, 0);
+                image(x + 256, y) = RGBA(0, bars[1](x, y), 0);
+                image(x + 512, y) = RGBA(0, 0, bars[2](x, y));
+            }
+        }
+
+        return image;
+    }
+
+    // One pixel per bin, the first value down and the second across. Brightness follows the log
+    // of the count, so sparse pairs stay visible next to dense ones.
+    inline GrayscaleImage render(const Joint &joint)
+    {
+        GrayscaleImage image(joint.bins, joint.bins);
+
+        int most = joint.counts.empty() ? 0 : *std::max_element(joint.counts.begin(), joint.counts.end());
+        double scale = most > 0 ? 255 / std::log1p(most) : 0;
+
+        for (int y = 0; y < joint.bins; y++)
+        {
+            for (int x = 0; x < joint.bins; x++)
+            {
+                image(x, y) = static_cast<Byte>(std::log1p(joint(y, x)) * scale + 0.5);
+            }
+        }
+
+        return image;
+    }
+
+    // ========== Equalization ==========
+    //
+    // Each operation counts a histogram, turns it into a 256-entry table and maps the pixels
+    // through it. The lookups are plain table reads; only the counting and CLAHE's blending
+    // between tiles have arithmetic worth splitting over threads as well.
+    using Table = std::array<Byte, 256>;
+
+    namespace __detail
+    {
+        inline Table identity()
+        {
+            Table table;
+
+            for (int level = 0; level < 256; level++)
+            {
+                table[level] = level;
+            }
+
+            return table;
+        }
+
+        inline int total(const Counts &counts)
+        {
+            int sum = 0;
+
+            for (int count : counts)
+            {
+                sum += count;
+            }
+
+            return sum;
+        }
+
+        // Maps the histogram's cumulative counts onto 0..255: level v goes to the share of pixels
+        // at or below it. `empty` of them are ignored, which lets global equalization send its
+        // darkest level to 0.
+        inline Table cumulative(const Counts &counts, int empty = 0)
+        {
+            int range = total(counts) - empty;
+
+            if (range <= 0)
+            {
+                return identity();
+            }
+
+            Table table;
+            long long sum = 0;
+
+            for (int level = 0; level < 256; level++)
+            {
+                sum += counts[level];
+                table[level] = static_cast<Byte>(std::clamp((sum - empty) * 255 * 2 / range + 1, 0LL, 511LL) / 2);
+            }
+
+            return table;
+        }
+    }
+
+    // Spreads the levels so the cumulative histogram becomes a straight line
+    inline Table equalization(const Counts &counts)
+    {
+        int darkest = 0;
+
+        while (darkest < 255 && counts[darkest] == 0)
+        {
+            darkest++;
+        }
+
+        return __detail::cumulative(counts, counts[darkest]);
+    }
+
+    // Stretches the levels linearly so that `clip` of the pixels at either end saturate to 0 and
+    // 255. A clip of 0 stretches the darkest level present to 0 and the brightest to 255.
+    inline Table levels(const Counts &counts, float clip = 0.005f)
+    {
+        long long limit = static_cast<long long>(std::clamp(clip, 0.0f, 0.5f) * __detail::total(counts));
+        long long below = 0, above = 0;
+        int low = 0, high = 255;
+
+        while (low < 255 && below + counts[low] <= limit)
+        {
+            below += counts[low++];
+        }
+
+        while (high > 0 && above + counts[high] <= limit)
+        {
+            above += counts[high--];
+        }
+
+        if (high <= low)
+        {
+            return __detail::identity();
+        }
+
+        Table table;
+
+        for (int level = 0; level < 256; level++)
+        {
+            table[level] = static_cast<Byte>(std::clamp((level - low) * 510 / (high - low) + 1, 0, 511) / 2);
+        }
+
+        return table;
+    }
+
+    inline void apply(GrayscaleImage &image, const Table &table, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        int width = image.GetWidth();
+
+        if (width <= 0)
+        {
+            return;
+        }
+
+        parallel::forEach(image.GetHeight(), [&](int begin, int end)
+                          {
+                              for (int y = begin; y < end; y++)
+                              {
+                                  Byte *row = &image(0, y);
+
+                                  for (int x = 0; x < width; x++)
+                                  {
+                                      row[x] = table[row[x]];
+                                  }
+                              }
+                          },
+                          execution);
+    }
+
+    inline void equalize(GrayscaleImage &image, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        apply(image, equalization(count(image, execution)), execution);
+    }
+
+    inline void autoLevels(GrayscaleImage &image, float clip = 0.005f, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        apply(image, levels(count(image, execution), clip), execution);
+    }
+
+    // Equalizes the luma and moves red, green and blue by the same amount as their luma. Since
+    // the weights add up to 1 that keeps both color difference channels, Cb and Cr, unchanged;
+    // only pixels pushed past 0 or 255 lose some of their color.
+    inline void equalize(ColorImage &image, luma::Weights weights = luma::Weights::REC601, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        Table table = equalization(luminance(image, weights, execution));
+
+        int width = image.GetWidth();
+
+        if (width <= 0)
+        {
+            return;
+        }
+
+        const luma::__detail::Shifts shift = luma::__detail::shifts();
+        const std::uint32_t alpha = 255u << shift.a;
+
+        // Whole blocks are worked on as 32-bit words, like the luma kernel does
+        auto adjust = [&](std::uint32_t word, int level)
+        {
+            int offset = table[level] - level;
+            int r = std::min(std::max(int((word >> shift.r) & 255) + offset, 0), 255);
+            int g = std::min(std::max(int((word >> shift.g) & 255) + offset, 0), 255);
+            int b = std::min(std::max(int((word >> shift.b) & 255) + offset, 0), 255);
+
+            return (word & alpha) | std::uint32_t(r) << shift.r | std::uint32_t(g) << shift.g | std::uint32_t(b) << shift.b;
+        };
+
+        parallel::forEach(image.GetHeight(), [&](int begin, int end)
+                          {
+                              constexpr int BLOCK = __detail::BLOCK;
+
+                              std::uint32_t words[BLOCK];
+                              Byte levels[BLOCK];
+
+                              for (int y = begin; y < end; y++)
+                              {
+                                  RGBA *row = &image(0, y);
+
+                                  for (int x = 0; x < width; x += BLOCK)
+                                  {
+                                      int n = std::min(BLOCK, width - x);
+
+                                      luma::toGray(row + x, levels, n, weights);
+                                      std::memcpy(words, row + x, n * sizeof(RGBA));
+
+                                      if (n == BLOCK)
+                                      {
+                                          for (int j = 0; j < BLOCK; j++)
+                                          {
+                                              words[j] = adjust(words[j], levels[j]);
+                                          }
+                                      }
+                                      else
+                                      {
+                                          for (int j = 0; j < n; j++)
+                                          {
+                                              words[j] = adjust(words[j], levels[j]);
+                                          }
+                                      }
+
+                                      std::memcpy(row + x, words, n * sizeof(RGBA));
+                                  }
+                              }
+                          },
+                          execution);
+    }
+
+    // Contrast limited adaptive histogram equalization. The image is cut into tilesX x tilesY
+    // tiles and each tile gets its own equalization table, with every histogram bin capped at
+    // clipLimit times the tile's mean bin count and the excess spread over all bins; that keeps
+    // flat areas from turning into amplified noise. A clip limit of 0 leaves the counts alone.
+    // Pixels blend the tables of the four nearest tile centers bilinearly, so no seams show.
+    inline void clahe(GrayscaleImage &image, int tilesX = 8, int tilesY = 8, float clipLimit = 2.0f, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        int width = image.GetWidth(), height = image.GetHeight();
+
+        if (width <= 0 || height <= 0)
+        {
+            return;
+        }
+
+        if (tilesX < 1 || tilesY < 1 || tilesX > width || tilesY > height)
+        {
+            std::cerr << "CLAHE needs between 1 tile and one tile per pixel in each direction." << std::endl;
+            tilesX = std::clamp(tilesX, 1, width);
+            tilesY = std::clamp(tilesY, 1, height);
+        }
+
+        auto bound = [](int size, int tiles, int tile)
+        { return int((long long)size * tile / tiles); };
+
+        std::vector<Table> tables(tilesX * tilesY);
+
+        parallel::forEach(tilesX * tilesY, [&](int begin, int end)
+                          {
+                              std::vector<int> copies(__detail::COPIES * 256);
+
+                              for (int tile = begin; tile < end; tile++)
+                              {
+                                  int x0 = bound(width, tilesX, tile % tilesX), x1 = bound(width, tilesX, tile % tilesX + 1);
+                                  int y0 = bound(height, tilesY, tile / tilesX), y1 = bound(height, tilesY, tile / tilesX + 1);
+
+                                  std::fill(copies.begin(), copies.end(), 0);
+
+                                  for (int y = y0; y < y1; y++)
+                                  {
+                                      __detail::tally(x1 - x0, copies.data(), 256, [&](int i)
+                                                      { return image(x0 + i, y); });
+                                  }
+
+                                  Counts counts{};
+
+                                  for (int copy = 0; copy < __detail::COPIES; copy++)
+                                  {
+                                      for (int level = 0; level < 256; level++)
+                                      {
+                                          counts[level] += copies[copy * 256 + level];
+                                      }
+                                  }
+
+                                  if (clipLimit > 0)
+                                  {
+                                      int pixels = (x1 - x0) * (y1 - y0);
+                                      int limit = std::max(1, static_cast<int>(clipLimit * pixels / 256));
+                                      int excess = 0;
+
+                                      for (int &count : counts)
+                                      {
+                                          excess += std::max(0, count - limit);
+                                          count = std::min(count, limit);
+                                      }
+
+                                      // Whole shares to every bin, then the remainder one each to evenly spaced bins
+                                      int share = excess / 256, remainder = excess % 256;
+
+                                      for (int level = 0; level < 256; level++)
+                                      {
+                                          counts[level] += share + (remainder > 0 && level * remainder / 256 != (level + 1) * remainder / 256);
+                                      }
+                                  }
+
+                                  tables[tile] = __detail::cumulative(counts);
+                              }
+                          },
+                          execution);
+
+        // Neighbouring tile centers and the weight of the second, per column and per row
+        auto neighbours = [&](int size, int tiles, std::vector<int> &first, std::vector<int> &second, std::vector<float> &weight)
+        {
+            first.resize(size);
+            second.resize(size);
+            weight.resize(size);
+
+            float tileSize = static_cast<float>(size) / tiles;
+
+            for (int i = 0; i < size; i++)
+            {
+                float position = std::clamp((i + 0.5f) / tileSize - 0.5f, 0.0f, tiles - 1.0f);
+
+                first[i] = std::min(static_cast<int>(position), tiles - 1);
+                second[i] = std::min(first[i] + 1, tiles - 1);
+                weight[i] = position - first[i];
+            }
+        };
+
+        std::vector<int> left, right, top, bottom;
+        std::vector<float> across, down;
+
+        neighbours(width, tilesX, left, right, across);
+        neighbours(height, tilesY, top, bottom, down);
+
+        parallel::forEach(height, [&](int begin, int end)
+                          {
+                              for (int y = begin; y < end; y++)
+                              {
+                                  const Table *upper = &tables[top[y] * tilesX], *lower = &tables[bottom[y] * tilesX];
+                                  float wy = down[y];
+                                  Byte *row = &image(0, y);
+
+                                  for (int x = 0; x < width; x++)
+                                  {
+                                      int level = row[x];
+                                      float wx = across[x];
+
+                                      float above = upper[left[x]][level] + wx * (upper[right[x]][level] - upper[left[x]][level]);
+                                      float below = lower[left[x]][level] + wx * (lower[right[x]][level] - lower[left[x]][level]);
+
+                                      row[x] = static_cast<Byte>(above + wy * (below - above) + 0.5f);
+                                  }
+                              }
+                          },
+                          execution);
+    }
+}
+
+inline void SaveHist(const GrayscaleImage &im, std::string filename, double scale = 0.05)
+{
+    histogram::render(histogram::count(im), scale).Save(filename);
+}
+
+inline void SaveHist(const ColorImage &im, std::string filename, double scale = 0.05)
+{
+    histogram::render(histogram::channels(im), scale).Save(filename);
+}
@@ -7,21 +7,126 @@
 #include <string>
 #include <algorithm>
 #include <math.h>
+#include <cstdint>
+#include <cstring>
+#include "Parallel.h"
 
 typedef unsigned char Byte;
 
+namespace luma {
+	// Weights for color to gray conversion
+	enum class Weights {
+		REC601 = 0,
+		REC709
+	};
+
+	namespace __detail {
+		// Weights in units of 2^-22, so weighted sums of 8-bit channels fit an int. The rounding
+		// bias is a little over one half: exact ties such as 0.299r + 0.587g + 0.114b = n + 0.5
+		// round up, and the error of the fixed point weights never crosses a level, so every
+		// color gives exactly the rounded luma.
+		constexpr int SHIFT = 22;
+		constexpr int BIAS = (1 << (SHIFT - 1)) + 512;
+
+		struct Coefficients {
+			int r, g, b;
+		};
+
+		inline const Coefficients &coefficients(Weights weights) {
+			static const Coefficients rec601 = {1254097, 2462056, 478151};
+			static const Coefficients rec709 = {891709, 2999766, 302829};
+
+			return weights == Weights::REC709 ? rec709 : rec601;
+		}
+
+		inline Byte weigh(const Coefficients &c, int r, int g, int b) {
+			return (c.r * r + c.g * g + c.b * b + BIAS) >> SHIFT;
+		}
+	}
+}
+
 struct RGBA {
 	RGBA() : r(0), g(0), b(0), a(255) { }
 	RGBA(Byte r, Byte g, Byte b, Byte a = 255) : r(r), g(g), b(b), a(a) { }
 	RGBA(Byte lum) : r(lum), g(lum), b(lum), a(255) { }
 
+	// Rec.601 luma, rounded to nearest
 	Byte luminance() const {
-		return 0.299*r + 0.587*g + 0.114*b;
+		return luma::__detail::weigh(luma::__detail::coefficients(luma::Weights::REC601), r, g, b);
 	}
 
 	Byte r, g, b, a;
 };
 
+namespace luma {
+	namespace __detail {
+		constexpr int BLOCK = 16;
+
+		// Bit offsets of the channels when a pixel is read as one 32-bit word
+		struct Shifts {
+			int r, g, b, a;
+		};
+
+		inline Shifts shifts() {
+			std::uint32_t word = 1;
+			Byte first;
+			std::memcpy(&first, &word, 1);
+			return first ? Shifts{0, 8, 16, 24} : Shifts{24, 16, 8, 0};
+		}
+	}
+
+	// Gray levels of `count` pixels. Whole blocks of pixels are read as 32-bit words and the
+	// channels picked out with shifts, which the compiler turns into vector code; loading the
+	// channels one byte at a time keeps it scalar.
+	inline void toGray(const RGBA *pixels, Byte *levels, int count, Weights weights = Weights::REC601) {
+		using namespace __detail;
+
+		const Coefficients &c = coefficients(weights);
+		const Shifts shift = shifts();
+
+		int i = 0;
+
+		for (; i + BLOCK <= count; i += BLOCK) {
+			std::uint32_t words[BLOCK];
+			Byte block[BLOCK];
+
+			std::memcpy(words, pixels + i, sizeof words);
+
+			for (int j = 0; j < BLOCK; j++) {
+				int r = (words[j] >> shift.r) & 255, g = (words[j] >> shift.g) & 255, b = (words[j] >> shift.b) & 255;
+				block[j] = (c.r * r + c.g * g + c.b * b + BIAS) >> SHIFT;
+			}
+
+			std::copy(block, block + BLOCK, levels + i);
+		}
+
+		for (; i < count; i++) {
+			levels[i] = weigh(c, pixels[i].r, pixels[i].g, pixels[i].b);
+		}
+	}
+
+	// Opaque gray pixels from `count` levels
+	inline void toColor(const Byte *levels, RGBA *pixels, int count) {
+		using namespace __detail;
+
+		int i = 0;
+
+		for (; i + BLOCK <= count; i += BLOCK) {
+			RGBA block[BLOCK];
+
+			for (int j = 0; j < BLOCK; j++) {
+				block[j] = RGBA(levels[i + j]);
+			}
+
+			std::copy(block, block + BLOCK, pixels + i);
+		}
+
+		for (; i < count; i++) {
+			pixels[i] = RGBA(levels[i]);
+		}
+	}
+}
+
 class GrayscaleImage;
 
 class ColorImage {
@@ -33,7 +138,7 @@ public:
 	ColorImage(int width, int height) :
 		width(width), height(height), data(width*height) { }
 
-	ColorImage(const GrayscaleImage &);
+	ColorImage(const GrayscaleImage &, parallel::Execution execution = parallel::Execution::SERIAL);
 
 	RGBA &operator()(int x, int y) {
 		return data[x + y * width];
@@ -183,6 +288,8 @@ public:
 	}
 
 private:
+	friend class GrayscaleImage;
+
 	std::vector<RGBA> data;
 	int width, height;
 };
@@ -197,16 +304,14 @@ public:
 	GrayscaleImage(int width, int height) :
 		width(width), height(height), data(width*height) { }
 
-	GrayscaleImage(const ColorImage &im) {
+	GrayscaleImage(const ColorImage &im, luma::Weights weights = luma::Weights::REC601, parallel::Execution execution = parallel::Execution::SERIAL) {
 		width = im.GetWidth();
 		height = im.GetHeight();
 		data.resize(width*height);
 
-		for (int y = 0; y < height; y++) {
-			for (int x = 0; x < width; x++) {
-				data[x + y * width] = im(x, y).luminance();
-			}
-		}
+		parallel::forEach(height, [&](int begin, int end) {
+			luma::toGray(im.data.data() + begin * width, data.data() + begin * width, (end - begin) * width, weights);
+		}, execution);
 	}
 	int GetWidth() const { return width; }
 
@@ -359,67 +464,25 @@ public:
 	}
 
 private:
+	friend class ColorImage;
+
 	std::vector<Byte> data;
 	int width, height;
 };
 
-void SaveHist(const GrayscaleImage &im, std::string filename, double scale = 0.05) {
-	GrayscaleImage hist(256, 512);
-	std::vector<int> counts(256);
-
-	for (int y = 0; y < im.GetHeight(); y++) {
-		for (int x = 0; x < im.GetWidth(); x++) {
-			counts[im(x, y)]++;
-		}
-	}
-
-	for (int x = 0; x < 256; x++) {
-		for (int y = 0; y < std::min<int>(512, counts[x] * scale); y++) {
-			hist(x, 511 - y) = 255;
-		}
-	}
-
-	hist.Save(filename);
-}
-
-void SaveHist(const ColorImage &im, std::string filename, double scale = 0.05) {
-	ColorImage hist(768, 512);
-	std::vector<int> counts(768);
-
-	for (int y = 0; y < im.GetHeight(); y++) {
-		for (int x = 0; x < im.GetWidth(); x++) {
-			counts[im(x, y).r]++;
-			counts[im(x, y).g + 256]++;
-			counts[im(x, y).b + 512]++;
-		}
-	}
-
-	for (int x = 0; x < 768; x++) {
-		for (int y = 0; y < std::min<int>(512, counts[x] * scale); y++) {
-			if (x < 256)
-				hist(x, 511 - y).r = 255;
-			else if (x < 512)
-				hist(x, 511 - y).g = 255;
-			else
-				hist(x, 511 - y).b = 255;
-		}
-	}
-
-	hist.Save(filename);
-}
-
-ColorImage::ColorImage(const GrayscaleImage &im) {
+ColorImage::ColorImage(const GrayscaleImage &im, parallel::Execution execution) {
 	width = im.GetWidth();
 	height = im.GetHeight();
 	data.resize(width*height);
 
-	for (int y = 0; y < height; y++) {
-		for (int x = 0; x < width; x++) {
-			data[x + y * width] = im(x, y);
-		}
-	}
+	parallel::forEach(height, [&](int begin, int end) {
+		luma::toColor(im.data.data() + begin * width, data.data() + begin * width, (end - begin) * width);
+	}, execution);
 }
 
 int car(double val, int limit) {
 	return std::clamp((int)std::round(val), 0, limit);
-}
\ No newline at end of file
+}
+
+// SaveHist lives with the histogram counting it draws from
+#include "Histogram.h"
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "Image.h"
+#include "Color.h"
+#include "Parallel.h"
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace lut
+{
+    enum class Interpolation
+    {
+        TRILINEAR = 0,
+        TETRAHEDRAL
+    };
+
+    namespace __detail
+    {
+        // Where each 8-bit level falls on a grid of `size` points: the lower grid index and the
+        // fraction towards the next one. The top level uses the last cell with a fraction of 1, so
+        // index + 1 stays inside the grid.
+        struct Levels
+        {
+            std::array<int, 256> index;
+            std::array<float, 256> fraction;
+
+            explicit Levels(int size)
+            {
+                float scale = (size - 1) / 255.0f;
+
+                for (int level = 0; level < 256; level++)
+                {
+                    float position = level * scale;
+
+                    index[level] = std::min(static_cast<int>(position), size - 2);
+                    fraction[level] = position - index[level];
+                }
+            }
+        };
+    }
+
+    // A size x size x size grid of output colors, red varying fastest as in .cube files, with
+    // values in 0..1. Any per-pixel color transform baked into one costs the same to apply,
+    // however much work the transform itself does. 17, 33 and 65 are the usual sizes; a
+    // transform that bends sharply within one grid cell, like a curve that is steep near black,
+    // needs the larger ones.
+    class Lut3D
+    {
+    public:
+        // The identity grid
+        explicit Lut3D(int size = 33)
+        {
+            if (size < 2 || size > 256)
+            {
+                std::cerr << "LUT size must be between 2 and 256." << std::endl;
+                size = std::clamp(size, 2, 256);
+            }
+
+            resize(size);
+
+            for (int b = 0; b < size; b++)
+            {
+                for (int g = 0; g < size; g++)
+                {
+                    for (int r = 0; r < size; r++)
+                    {
+                        set(r, g, b, grid(r), grid(g), grid(b));
+                    }
+                }
+            }
+        }
+
+        // Samples transform(RGBA) -> RGBA at every grid point. Grid points between 8-bit levels
+        // are rounded to the nearest level first.
+        template <typename Transform>
+        static Lut3D bake(int size, Transform transform)
+        {
+            Lut3D lut(size);
+
+            for (int i = 0; i < lut.count(); i++)
+            {
+                RGBA input = lut.input(i);
+                RGBA output = transform(input);
+
+                lut.set(i, output.r / 255.0f, output.g / 255.0f, output.b / 255.0f);
+            }
+
+            return lut;
+        }
+
+        // Adjustment chains are run a grid row at a time rather than a pixel at a time
+        static Lut3D bake(int size, const color::Adjustments &adjustments, parallel::Execution execution = parallel::Execution::SERIAL)
+        {
+            Lut3D lut(size);
+
+            int points = lut.size;
+
+            parallel::forEach(points * points, [&](int begin, int end)
+                              {
+                                  std::vector<RGBA> row(points);
+
+                                  for (int line = begin; line < end; line++)
+                                  {
+                                      for (int r = 0; r < points; r++)
+                                      {
+                                          row[r] = lut.input(line * points + r);
+                                      }
+
+                                      adjustments.apply(row.data(), points);
+
+                                      for (int r = 0; r < points; r++)
+                                      {
+                                          lut.set(line * points + r, row[r].r / 255.0f, row[r].g / 255.0f, row[r].b / 255.0f);
+                                      }
+                                  }
+                              },
+                              execution);
+
+            return lut;
+        }
+
+        int getSize() const { return size; }
+
+        RGBA operator()(RGBA pixel, Interpolation interpolation = Interpolation::TETRAHEDRAL) const
+        {
+            apply(&pixel, 1, interpolation);
+            return pixel;
+        }
+
+        // Maps `count` pixels in place; alpha is left alone
+        void apply(RGBA *pixels, int count, Interpolation interpolation = Interpolation::TETRAHEDRAL) const
+        {
+            if (interpolation == Interpolation::TRILINEAR)
+            {
+                applyTrilinear(pixels, count);
+            }
+            else
+            {
+                applyTetrahedral(pixels, count);
+            }
+        }
+
+        void apply(ColorImage &image, Interpolation interpolation = Interpolation::TETRAHEDRAL, parallel::Execution execution = parallel::Execution::SERIAL) const
+        {
+            int width = image.GetWidth();
+
+            if (width <= 0)
+            {
+                return;
+            }
+
+            parallel::forEach(image.GetHeight(), [&](int begin, int end)
+                              {
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      apply(&image(0, y), width, interpolation);
+                                  }
+                              },
+                              execution);
+        }
+
+        // Writes the grid as an Adobe .cube file
+        bool save(const std::string &filename) const
+        {
+            std::ofstream file(filename);
+
+            if (!file)
+            {
+                std::cerr << "Could not open file " << filename << " for writing" << std::endl;
+                return false;
+            }
+
+            file << "LUT_3D_SIZE " << size << "\n";
+            file << std::fixed << std::setprecision(6);
+
+            for (int i = 0; i < count(); i++)
+            {
+                file << values[3 * i] << " " << values[3 * i + 1] << " " << values[3 * i + 2] << "\n";
+            }
+
+            return static_cast<bool>(file);
+        }
+
+        // Reads a 3D .cube file. Comments, TITLE and a 0..1 DOMAIN are accepted; 1D tables and
+        // other domains are not. The LUT is left unchanged when the file cannot be used.
+        bool load(const std::string &filename)
+        {
+            std::ifstream file(filename);
+
+            if (!file)
+            {
+                std::cerr << "Could not open file " << filename << " for reading" << std::endl;
+                return false;
+            }
+
+            int points = 0;
+            std::vector<float> read;
+            std::string line;
+
+            while (std::getline(file, line))
+            {
+                std::istringstream fields(line);
+                std::string keyword;
+
+                if (!(fields >> keyword) || keyword[0] == '#' || keyword == "TITLE")
+                {
+                    continue;
+                }
+
+                if (keyword == "LUT_3D_SIZE")
+                {
+                    fields >> points;
+
+                    if (points < 2 || points > 256)
+                    {
+                        std::cerr << "Unsupported LUT_3D_SIZE in " << filename << std::endl;
+                        return false;
+                    }
+
+                    read.reserve(3 * points * points * points);
+                }
+                else if (keyword == "DOMAIN_MIN" || keyword == "DOMAIN_MAX")
+                {
+                    float expected = keyword == "DOMAIN_MIN" ? 0.0f : 1.0f, bound;
+
+                    for (int channel = 0; channel < 3; channel++)
+                    {
+                        if (!(fields >> bound) || bound != expected)
+                        {
+                            std::cerr << "Only a 0..1 domain is supported in " << filename << std::endl;
+                            return false;
+                        }
+                    }
+                }
+                else if (keyword == "LUT_1D_SIZE")
+                {
+                    std::cerr << "1D LUTs are not supported in " << filename << std::endl;
+                    return false;
+                }
+                else
+                {
+                    float r, g, b;
+
+                    std::istringstream entry(line);
+
+                    if (!(entry >> r >> g >> b))
+                    {
+                        std::cerr << "Unexpected line in " << filename << ": " << line << std::endl;
+                        return false;
+                    }
+
+                    read.push_back(r);
+                    read.push_back(g);
+                    read.push_back(b);
+                }
+            }
+
+            if (points == 0 || static_cast<int>(read.size()) != 3 * points * points * points)
+            {
+                std::cerr << "Expected " << points * points * points << " entries in " << filename << std::endl;
+                return false;
+            }
+
+            size = points;
+            values = std::move(read);
+            levels = __detail::Levels(size);
+
+            for (float &value : values)
+            {
+                value = std::clamp(value, 0.0f, 1.0f);
+            }
+
+            return true;
+        }
+
+    private:
+        int size;
+        std::vector<float> values;
+        // Grid positions of the 8-bit levels, rebuilt whenever size changes
+        __detail::Levels levels{2};
+
+        void resize(int points)
+        {
+            size = points;
+            values.assign(3 * count(), 0.0f);
+            levels = __detail::Levels(size);
+        }
+
+        int count() const { return size * size * size; }
+
+        float grid(int index) const { return static_cast<float>(index) / (size - 1); }
+
+        void set(int r, int g, int b, float red, float green, float blue)
+        {
+            set((b * size + g) * size + r, red, green, blue);
+        }
+
+        void set(int i, float red, float green, float blue)
+        {
+            values[3 * i] = red;
+            values[3 * i + 1] = green;
+            values[3 * i + 2] = blue;
+        }
+
+        RGBA input(int i) const
+        {
+            auto level = [&](int index)
+            { return static_cast<Byte>(index * 255 / (size - 1.0f) + 0.5f); };
+
+            return RGBA(level(i % size), level(i / size % size), level(i / (size * size)));
+        }
+
+        // Interpolation weights are positive and sum to 1, so results stay within the 0..1 values
+        static Byte toByte(float value)
+        {
+            return static_cast<int>(value * 255.0f + 0.5f);
+        }
+
+        // Splits each cube cell into six tetrahedra along its gray diagonal. The fractions sorted
+        // from largest to smallest pick the tetrahedron; its four corners are the cell origin,
+        // one and two steps along the largest axes, and the far corner. Ties are broken in a
+        // fixed order so the largest and smallest axes always differ.
+        void applyTetrahedral(RGBA *pixels, int count) const
+        {
+            int redStride = 3, greenStride = 3 * size, blueStride = 3 * size * size;
+            int far = redStride + greenStride + blueStride;
+
+            for (int x = 0; x < count; x++)
+            {
+                RGBA pixel = pixels[x];
+
+                float fr = levels.fraction[pixel.r], fg = levels.fraction[pixel.g], fb = levels.fraction[pixel.b];
+
+                bool redLargest = fr >= fg && fr >= fb, greenLargest = !redLargest && fg >= fb;
+                bool blueSmallest = fb <= fr && fb <= fg, greenSmallest = !blueSmallest && fg <= fr;
+
+                int first = redLargest ? redStride : greenLargest ? greenStride : blueStride;
+                int second = far - (blueSmallest ? blueStride : greenSmallest ? greenStride : redStride);
+
+                float high = std::max(fr, std::max(fg, fb)), low = std::min(fr, std::min(fg, fb));
+                float middle = fr + fg + fb - high - low;
+                float w0 = 1 - high, w1 = high - middle, w2 = middle - low, w3 = low;
+
+                const float *origin = &values[redStride * levels.index[pixel.r] + greenStride * levels.index[pixel.g] + blueStride * levels.index[pixel.b]];
+
+                pixels[x] = RGBA(toByte(w0 * origin[0] + w1 * origin[first] + w2 * origin[second] + w3 * origin[far]),
+                                 toByte(w0 * origin[1] + w1 * origin[first + 1] + w2 * origin[second + 1] + w3 * origin[far + 1]),
+                                 toByte(w0 * origin[2] + w1 * origin[first + 2] + w2 * origin[second + 2] + w3 * origin[far + 2]),
+                                 pixel.a);
+            }
+        }
+
+        void applyTrilinear(RGBA *pixels, int count) const
+        {
+            int redStride = 3, greenStride = 3 * size, blueStride = 3 * size * size;
+
+            for (int x = 0; x < count; x++)
+            {
+                RGBA pixel = pixels[x];
+
+                float fr = levels.fraction[pixel.r], fg = levels.fraction[pixel.g], fb = levels.fraction[pixel.b];
+
+                const float *corner = &values[redStride * levels.index[pixel.r] + greenStride * levels.index[pixel.g] + blueStride * levels.index[pixel.b]];
+                float result[3];
+
+                for (int channel = 0; channel < 3; channel++)
+                {
+                    const float *c = corner + channel;
+
+                    float c00 = c[0] + fr * (c[redStride] - c[0]);
+                    float c10 = c[greenStride] + fr * (c[greenStride + redStride] - c[greenStride]);
+                    float c01 = c[blueStride] + fr * (c[blueStride + redStride] - c[blueStride]);
+                    float c11 = c[blueStride + greenStride] + fr * (c[blueStride + greenStride + redStride] - c[blueStride + greenStride]);
+
+                    float c0 = c00 + fg * (c10 - c00);
+                    float c1 = c01 + fg * (c11 - c01);
+
+                    result[channel] = c0 + fb * (c1 - c0);
+                }
+
+                pixels[x] = RGBA(toByte(result[0]), toByte(result[1]), toByte(result[2]), pixel.a);
+            }
+        }
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace parallel
+{
+    enum class Execution
+    {
+        SERIAL = 0,
+        PARALLEL
+    };
+
+    inline int threadCount()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Splits [0, count) into one contiguous chunk per thread and runs task(begin, end) on each.
+    // The calling thread takes the first chunk; with SERIAL the whole range runs on it.
+    template <typename Task>
+    void forEach(int count, Task task, Execution execution = Execution::PARALLEL)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+
+        int threads = execution == Execution::SERIAL ? 1 : std::min(threadCount(), count);
+
+        if (threads == 1)
+        {
+            task(0, count);
+            return;
+        }
+
+        auto bound = [&](int i) { return int((long long)count * i / threads); };
+
+        std::vector<std::thread> workers;
+
+        for (int i = 1; i < threads; i++)
+        {
+            workers.emplace_back(task, bound(i), bound(i + 1));
+        }
+
+        task(0, bound(1));
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,353 @@
+#pragma once
+
+#include "Image.h"
+#include "Line.h"
+#include "Curve.h"
+#include "Polygon.h"
+#include <stdexcept>
+
+namespace path
+{
+    using polygon::WindingRule;
+
+    namespace __detail
+    {
+        enum class Command
+        {
+            MOVE = 0,
+            LINE,
+            QUAD,
+            CUBIC,
+            CLOSE
+        };
+
+        struct Contour
+        {
+            std::vector<curve::FloatPoint> points;
+            bool closed;
+        };
+
+        inline Point toPoint(curve::FloatPoint point)
+        {
+            return point;
+        }
+
+        // Signed area is negative for contours whose edges count +1 under polygon::__detail::addEdges
+        inline void orient(std::vector<curve::FloatPoint> &points)
+        {
+            double area = 0;
+            int n = points.size();
+
+            for (int i = 0; i < n; i++)
+            {
+                const curve::FloatPoint &p1 = points[i], &p2 = points[(i + 1) % n];
+                area += (double)p1.x * p2.y - (double)p2.x * p1.y;
+            }
+
+            if (area > 0)
+            {
+                std::reverse(points.begin(), points.end());
+            }
+        }
+    }
+
+    // A shape made of move/line/quad/cubic/close commands. Every contour is filled as if closed;
+    // only contours ended by close() are stroked closed.
+    class Path
+    {
+    public:
+        Path &moveTo(Point point)
+        {
+            commands.push_back(__detail::Command::MOVE);
+            points.push_back(toFloat(point));
+            return *this;
+        }
+
+        Path &lineTo(Point point)
+        {
+            requireStart();
+            commands.push_back(__detail::Command::LINE);
+            points.push_back(toFloat(point));
+            return *this;
+        }
+
+        Path &quadTo(Point control, Point point)
+        {
+            requireStart();
+            commands.push_back(__detail::Command::QUAD);
+            points.push_back(toFloat(control));
+            points.push_back(toFloat(point));
+            return *this;
+        }
+
+        Path &cubicTo(Point control1, Point control2, Point point)
+        {
+            requireStart();
+            commands.push_back(__detail::Command::CUBIC);
+            points.push_back(toFloat(control1));
+            points.push_back(toFloat(control2));
+            points.push_back(toFloat(point));
+            return *this;
+        }
+
+        Path &close()
+        {
+            requireStart();
+            commands.push_back(__detail::Command::CLOSE);
+            return *this;
+        }
+
+        void clear()
+        {
+            commands.clear();
+            points.clear();
+        }
+
+        bool empty() const { return commands.empty(); }
+
+        // Converts every curve into line segments that stay within `tolerance` pixels of it
+        std::vector<__detail::Contour> flatten(float tolerance = 0.25f) const
+        {
+            std::vector<__detail::Contour> contours;
+
+            curve::FloatPoint start{0, 0}, current{0, 0};
+            bool reopen = false;
+            int index = 0;
+
+            auto contour = [&]() -> std::vector<curve::FloatPoint> &
+            {
+                if (reopen)
+                {
+                    contours.push_back({{start}, false});
+                    reopen = false;
+                }
+
+                return contours.back().points;
+            };
+
+            for (__detail::Command command : commands)
+            {
+                switch (command)
+                {
+                case __detail::Command::MOVE:
+                    start = current = points[index++];
+                    contours.push_back({{start}, false});
+                    reopen = false;
+                    break;
+                case __detail::Command::LINE:
+                    current = points[index++];
+                    contour().push_back(current);
+                    break;
+                case __detail::Command::QUAD:
+                    flattenCurve<3>(contour(), {current, points[index], points[index + 1]}, tolerance);
+                    current = points[index + 1];
+                    index += 2;
+                    break;
+                case __detail::Command::CUBIC:
+                    flattenCurve<4>(contour(), {current, points[index], points[index + 1], points[index + 2]}, tolerance);
+                    current = points[index + 2];
+                    index += 3;
+                    break;
+                case __detail::Command::CLOSE:
+                    contour();
+                    contours.back().closed = true;
+                    current = start;
+                    reopen = true;
+                    break;
+                }
+            }
+
+            return contours;
+        }
+
+    private:
+        std::vector<__detail::Command> commands;
+        std::vector<curve::FloatPoint> points;
+
+        static curve::FloatPoint toFloat(Point point)
+        {
+            return {(float)point.x, (float)point.y};
+        }
+
+        void requireStart() const
+        {
+            if (commands.empty())
+            {
+                throw std::logic_error("Path must start with moveTo");
+            }
+        }
+
+        template <int Degree>
+        static void flattenCurve(std::vector<curve::FloatPoint> &contour, const curve::__detail::ControlPoints<Degree> &controlPoints, float tolerance)
+        {
+            bool first = true;
+
+            curve::__detail::flattenCurve<Degree>(controlPoints, curve::__detail::estimateSegments<Degree>(controlPoints, tolerance), [&](curve::FloatPoint point)
+                                                  {
+                                                      if (!first)
+                                                      {
+                                                          contour.push_back(point);
+                                                      }
+                                                      first = false; });
+        }
+    };
+
+    namespace __detail
+    {
+        template <typename Image, typename FillColor>
+        void fillPath(Image &image, const Path &path, FillColor fillColor, WindingRule windingRule, float tolerance)
+        {
+            std::vector<polygon::__detail::Line> lines;
+
+            for (const Contour &contour : path.flatten(tolerance))
+            {
+                polygon::__detail::addEdges(lines, contour.points, image.GetHeight());
+            }
+
+            polygon::__detail::fillEdges(image, lines, fillColor, windingRule, polygon::__detail::Sampling::PIXEL_CENTER);
+        }
+
+        // Adds one polygon per segment (butt ends) and one bevel triangle per join on each side,
+        // all oriented alike, so a single POSITIVE fill paints their union exactly once per pixel
+        inline void addStrokeEdges(std::vector<polygon::__detail::Line> &lines, const Contour &contour, float width, int height)
+        {
+            std::vector<curve::FloatPoint> points;
+
+            for (const curve::FloatPoint &point : contour.points)
+            {
+                if (points.empty() || point.x != points.back().x || point.y != points.back().y)
+                {
+                    points.push_back(point);
+                }
+            }
+
+            if (contour.closed && points.size() > 2 && points.front().x == points.back().x && points.front().y == points.back().y)
+            {
+                points.pop_back();
+            }
+
+            int n = points.size();
+            int segments = contour.closed && n > 2 ? n : n - 1;
+
+            std::vector<curve::FloatPoint> normals(segments);
+
+            for (int i = 0; i < segments; i++)
+            {
+                const curve::FloatPoint &p1 = points[i], &p2 = points[(i + 1) % n];
+
+                float dx = p2.x - p1.x;
+                float dy = p2.y - p1.y;
+                float scale = width / 2 / std::sqrt(dx * dx + dy * dy);
+
+                normals[i] = {-dy * scale, dx * scale};
+            }
+
+            std::vector<curve::FloatPoint> polygon;
+
+            auto add = [&](std::initializer_list<curve::FloatPoint> corners)
+            {
+                polygon.assign(corners);
+
+                orient(polygon);
+                polygon::__detail::addEdges(lines, polygon, height);
+            };
+
+            for (int i = 0; i < segments; i++)
+            {
+                const curve::FloatPoint &p1 = points[i], &p2 = points[(i + 1) % n], &normal = normals[i];
+
+                add({{p1.x + normal.x, p1.y + normal.y},
+                     {p2.x + normal.x, p2.y + normal.y},
+                     {p2.x - normal.x, p2.y - normal.y},
+                     {p1.x - normal.x, p1.y - normal.y}});
+            }
+
+            for (int i = contour.closed ? 0 : 1; i < segments; i++)
+            {
+                const curve::FloatPoint &vertex = points[i];
+                const curve::FloatPoint &before = normals[(i + segments - 1) % segments], &after = normals[i];
+
+                add({vertex, {vertex.x + before.x, vertex.y + before.y}, {vertex.x + after.x, vertex.y + after.y}});
+                add({vertex, {vertex.x - before.x, vertex.y - before.y}, {vertex.x - after.x, vertex.y - after.y}});
+            }
+        }
+
+        template <typename Image, typename Color>
+        void strokePath(Image &image, const Path &path, Color color, float width, float tolerance)
+        {
+            std::vector<Contour> contours = path.flatten(tolerance);
+
+            // Hairlines go straight to the line rasterizer
+            if (width <= 1.0f)
+            {
+                for (const Contour &contour : contours)
+                {
+                    int n = contour.points.size();
+
+                    for (int i = 0; i + 1 < n; i++)
+                    {
+                        line::drawLine(image, toPoint(contour.points[i]), toPoint(contour.points[i + 1]), color);
+                    }
+
+                    if (contour.closed && n > 1)
+                    {
+                        line::drawLine(image, toPoint(contour.points[n - 1]), toPoint(contour.points[0]), color);
+                    }
+                }
+
+                return;
+            }
+
+            std::vector<polygon::__detail::Line> lines;
+
+            for (const Contour &contour : contours)
+            {
+                addStrokeEdges(lines, contour, width, image.GetHeight());
+            }
+
+            polygon::__detail::fillEdges(image, lines, color, WindingRule::POSITIVE, polygon::__detail::Sampling::PIXEL_CENTER);
+        }
+    }
+
+    // ========== GrayscaleImage ==========
+    inline void fillPath(GrayscaleImage &image, const Path &path, Byte fillColor = 255, WindingRule windingRule = WindingRule::ODD, float tolerance = 0.25f)
+    {
+        __detail::fillPath(image, path, fillColor, windingRule, tolerance);
+    }
+
+    inline void fillPath(GrayscaleImage &image, const Path &path, gradient::Gradient fillColor, WindingRule windingRule = WindingRule::ODD, float tolerance = 0.25f)
+    {
+        __detail::fillPath(image, path, fillColor, windingRule, tolerance);
+    }
+
+    inline void fillPath(GrayscaleImage &image, const Path &path, const gradient::StopGradient &fillColor, WindingRule windingRule = WindingRule::ODD, float tolerance = 0.25f)
+    {
+        __detail::fillPath(image, path, fillColor, windingRule, tolerance);
+    }
+
+    inline void strokePath(GrayscaleImage &image, const Path &path, Byte color = 255, float width = 1.0f, float tolerance = 0.25f)
+    {
+        __detail::strokePath(image, path, color, width, tolerance);
+    }
+
+    // ========== ColorImage ==========
+    inline void fillPath(ColorImage &image, const Path &path, RGBA fillColor = RGBA(255, 255, 255), WindingRule windingRule = WindingRule::ODD, float tolerance = 0.25f)
+    {
+        __detail::fillPath(image, path, fillColor, windingRule, tolerance);
+    }
+
+    inline void fillPath(ColorImage &image, const Path &path, gradient::RGBGradient fillColor, WindingRule windingRule = WindingRule::ODD, float tolerance = 0.25f)
+    {
+        __detail::fillPath(image, path, fillColor, windingRule, tolerance);
+    }
+
+    inline void fillPath(ColorImage &image, const Path &path, const gradient::RGBStopGradient &fillColor, WindingRule windingRule = WindingRule::ODD, float tolerance = 0.25f)
+    {
+        __detail::fillPath(image, path, fillColor, windingRule, tolerance);
+    }
+
+    inline void strokePath(ColorImage &image, const Path &path, RGBA color = RGBA(255, 255, 255), float width = 1.0f, float tolerance = 0.25f)
+    {
+        __detail::strokePath(image, path, color, width, tolerance);
+    }
+}
@@ -2,8 +2,12 @@
 
 #include "Image.h"
 #include "Line.h"
+#include "Curve.h"
 #include "Gradient.h"
+#include "Parallel.h"
+#include <iostream>
 #include <optional>
+#include <limits>
 
 namespace polygon
 {
@@ -22,156 +26,441 @@ namespace polygon
             int direction;
         };
 
-        template <typename Image, typename OutlineColor, typename FillColor>
-        void drawPolygon(Image &image, const std::vector<Point> &points, OutlineColor outlineColor, std::optional<FillColor> fillColor, bool skipOutline, WindingRule windingRule = WindingRule::ODD)
+        inline bool shouldFill(int winding, WindingRule windingRule)
+        {
+            if (windingRule == WindingRule::ODD)
+            {
+                return winding % 2;
+            }
+            else // if (windingRule == WindingRule::POSITIVE)
+            {
+                return winding > 0;
+            }
+        }
+
+        // Appends the non-horizontal edges of the closed contour `points` that can reach the image rows
+        inline void addEdges(std::vector<Line> &lines, const std::vector<Point> &points, int height)
         {
             int n = points.size();
 
-            if (fillColor.has_value())
+            for (int i = 0; i < n; i++)
             {
-                std::vector<__detail::Line> lines;
+                Point p1 = points[i], p2 = points[(i + 1) % n];
 
-                int y_min = points[0].y, y_max = points[0].y;
-                int x_min = points[0].x, x_max = points[0].x;
+                int direction;
 
-                for (int i = 0; i < n; i++)
+                if (p1.y > p2.y)
                 {
-                    Point p1 = points[i], p2 = points[(i + 1) % n];
+                    std::swap(p1, p2);
+                    direction = -1;
+                }
+                else
+                {
+                    direction = 1;
+                }
 
-                    int direction;
+                if (p1.y == p2.y || p1.y > height || p2.y < 0)
+                {
+                    continue;
+                }
 
-                    if (p1.y > p2.y)
-                    {
-                        std::swap(p1, p2);
-                        direction = -1;
-                    }
-                    else
-                    {
-                        direction = 1;
-                    }
+                lines.push_back({p1.y, p2.y, float(p1.x), (p2.x - p1.x) / float(p2.y - p1.y), direction});
+            }
+        }
 
-                    if (p1.y == p2.y || p1.y > image.GetHeight() || p2.y < 0)
-                    {
-                        continue;
-                    }
+        // Appends the edges of a contour with sub-pixel vertices. Rows are sampled at pixel centres,
+        // so an edge covers the rows whose centre lies in [top, bottom) and `x` is its crossing at
+        // the centre of its first row. Both endpoints go through the same arithmetic whichever
+        // polygon the edge belongs to, so a shared edge crosses every row at the same x.
+        inline void addEdges(std::vector<Line> &lines, const std::vector<curve::FloatPoint> &points, int height)
+        {
+            int n = points.size();
 
-                    lines.push_back({p1.y, p2.y, float(p1.x), (p2.x - p1.x) / float(p2.y - p1.y), direction});
+            for (int i = 0; i < n; i++)
+            {
+                curve::FloatPoint p1 = points[i], p2 = points[(i + 1) % n];
 
-                    x_min = std::min(x_min, std::min(p1.x, p2.x));
-                    x_max = std::max(x_max, std::max(p1.x, p2.x));
-                    y_min = std::min(y_min, std::min(p1.y, p2.y));
-                    y_max = std::max(y_max, std::max(p1.y, p2.y));
+                int direction;
+
+                if (p1.y > p2.y)
+                {
+                    std::swap(p1, p2);
+                    direction = -1;
+                }
+                else
+                {
+                    direction = 1;
                 }
 
-                Point center = {(x_min + x_max) / 2, (y_min + y_max) / 2};
+                int y_min = int(std::ceil(p1.y - 0.5f));
+                int y_max = int(std::ceil(p2.y - 0.5f));
 
-                std::vector<__detail::Line> activeLines;
-                std::vector<std::pair<Point, Point>> fillLines;
-                int pointCount = 0;
+                if (y_min == y_max || y_min > height || y_max < 0)
+                {
+                    continue;
+                }
+
+                float slope_inverse = (p2.x - p1.x) / (p2.y - p1.y);
+
+                lines.push_back({y_min, y_max, p1.x + slope_inverse * (y_min + 0.5f - p1.y), slope_inverse, direction});
+            }
+        }
+
+        // How crossings become pixels. ROUNDED is the integer-vertex behaviour: both ends are rounded
+        // and filled inclusively, so neighbours overlap on shared edges. PIXEL_CENTER is the top-left
+        // rule for sub-pixel edges: a pixel is filled when its centre lies in [left, right), so
+        // polygons sharing an edge fill every pixel along it exactly once.
+        enum class Sampling
+        {
+            ROUNDED = 0,
+            PIXEL_CENTER
+        };
+
+        // Converts a pair of crossings into an inclusive pixel span, false if it covers no pixel
+        inline bool toSpan(float x_left, float x_right, Sampling sampling, int &x_start, int &x_end)
+        {
+            if (sampling == Sampling::ROUNDED)
+            {
+                x_start = int(std::round(x_left));
+                x_end = int(std::round(x_right));
+                return x_end > x_start;
+            }
+
+            x_start = int(std::ceil(x_left - 0.5f));
+            x_end = int(std::ceil(x_right - 0.5f)) - 1;
+            return x_end >= x_start;
+        }
+
+        // Where `line` crosses row y. Computed from the edge's first row rather than accumulated, so
+        // a scan started at any row (a clipped or parallel band) lands on exactly the same pixels.
+        inline float edgeX(const Line &line, int y)
+        {
+            return line.x + line.slope_inverse * (y - line.y_min);
+        }
+
+        struct ActiveLine
+        {
+            float x;
+            Line edge;
+        };
+
+        // Visible rows [y_begin, y_end) that the edges cover
+        inline std::pair<int, int> rowRange(const std::vector<Line> &lines, int y_begin, int y_end)
+        {
+            int y_min = y_end, y_max = y_begin;
 
-                for (int y = y_min; y <= y_max; y++)
+            for (const auto &line : lines)
+            {
+                if (line.y_max > y_begin && line.y_min < y_end)
                 {
-                    for (int i = 0; i < activeLines.size(); i++)
-                    {
-                        if (activeLines[i].y_max == y)
-                        {
-                            activeLines.erase(activeLines.begin() + i);
-                            i--;
-                        }
-                    }
+                    y_min = std::min(y_min, std::max(line.y_min, y_begin));
+                    y_max = std::max(y_max, std::min(line.y_max, y_end));
+                }
+            }
 
-                    for (int i = 0; i < lines.size(); i++)
-                    {
-                        if (lines[i].y_min == y)
-                        {
-                            activeLines.push_back(lines[i]);
-                            lines.erase(lines.begin() + i);
-                            i--;
-                        }
-                    }
+            return {y_min, y_max};
+        }
 
-                    std::sort(activeLines.begin(), activeLines.end(), [](const auto &a, const auto &b) { return a.x < b.x; });
+        // Scan converts an edge list built by addEdges, so shapes made of several contours
+        // (holes, curved paths) are filled in one pass under a single winding rule. Each span is
+        // handed to emit(y, x_start, x_end) (inclusive) as soon as its scanline is produced.
+        // Only rows inside [y_begin, y_end) are visited: edges that start above the range join at
+        // its first row, so cost follows the visible part of the shape. Spans are not clipped
+        // horizontally because edges left of the image still count towards the winding.
+        template <typename Emit>
+        void scanEdges(const std::vector<Line> &lines, int y_begin, int y_end, WindingRule windingRule, Sampling sampling, Emit emit)
+        {
+            auto [y_min, y_max] = rowRange(lines, y_begin, y_end);
 
-                    std::vector<std::pair<float, int>> x_coords;
+            if (y_min >= y_max)
+            {
+                return;
+            }
 
-                    for (auto &line : activeLines)
-                    {
-                        x_coords.push_back({line.x, line.direction});
-                        line.x += line.slope_inverse;
-                    }
+            // Edge table: edges bucketed by the row they start on (a counting sort, since the scan
+            // below visits every row anyway) and consumed in order by a cursor
+            std::vector<int> buckets(y_max - y_min + 2);
 
-                    int winding = 0;
-                    int fill_start = -1;
+            for (const auto &line : lines)
+            {
+                if (line.y_max > y_min && line.y_min < y_max)
+                {
+                    buckets[std::max(line.y_min, y_min) - y_min + 1]++;
+                }
+            }
 
-                    for (const auto &x_coord : x_coords)
-                    {
-                        winding += x_coord.second;
+            for (int i = 1; i < (int)buckets.size(); i++)
+            {
+                buckets[i] += buckets[i - 1];
+            }
 
-                        bool should_fill;
+            std::vector<__detail::Line> edgeTable(buckets.back());
 
-                        if (windingRule == WindingRule::ODD)
-                        {
-                            should_fill = winding % 2;
-                        }
-                        else // if (windingRule == WindingRule::POSITIVE)
-                        {
-                            should_fill = winding > 0;
-                        }
+            for (const auto &line : lines)
+            {
+                if (line.y_max > y_min && line.y_min < y_max)
+                {
+                    edgeTable[buckets[std::max(line.y_min, y_min) - y_min]++] = line;
+                }
+            }
 
-                        if (should_fill && fill_start < 0)
-                        {
-                            fill_start = int(std::round(x_coord.first));
-                        }
-                        else if (!should_fill && fill_start >= 0)
-                        {
-                            int fill_end = int(std::round(x_coord.first));
-                            if (fill_end > fill_start)
-                            {
-                                fillLines.push_back({{fill_start, y}, {fill_end, y}});
-                                pointCount += fill_end - fill_start + 1;
-                            }
-                            fill_start = -1;
-                        }
-                    }
+            std::vector<ActiveLine> activeLines;
+            activeLines.reserve(edgeTable.size());
+
+            int nextLine = 0;
+
+            for (int y = y_min; y < y_max; y++)
+            {
+                activeLines.erase(std::remove_if(activeLines.begin(), activeLines.end(), [y](const ActiveLine &line) { return line.edge.y_max == y; }), activeLines.end());
+
+                while (nextLine < (int)edgeTable.size() && std::max(edgeTable[nextLine].y_min, y_min) == y)
+                {
+                    activeLines.push_back({0, edgeTable[nextLine++]});
                 }
 
-                if constexpr (std::is_same_v<FillColor, gradient::Gradient> ||
-                              std::is_same_v<FillColor, gradient::RGBGradient>)
+                for (auto &line : activeLines)
                 {
-                    FillColor gradient = fillColor.value();
+                    line.x = edgeX(line.edge, y);
+                }
 
-                    if (gradient.isDirectional())
+                // Edges only swap order where they cross, so the list stays nearly sorted from one
+                // row to the next and insertion sort runs in close to linear time. Shapes whose edges
+                // cross on most rows exhaust the move budget and fall back to a full sort.
+                int moves = 4 * activeLines.size();
+
+                for (int i = 1; i < (int)activeLines.size() && moves >= 0; i++)
+                {
+                    ActiveLine line = activeLines[i];
+                    int j = i - 1;
+
+                    while (j >= 0 && activeLines[j].x > line.x)
                     {
-                        gradient.prepareDirectional(center, fillLines);
+                        activeLines[j + 1] = activeLines[j];
+                        j--;
+                        moves--;
+                    }
 
-                        for (const auto &line : fillLines)
-                        {
-                            for (int x = line.first.x; x <= line.second.x; x++)
-                            {
-                                image(x, line.first.y) = gradient.at(x, line.first.y);
-                            }
-                        }
+                    activeLines[j + 1] = line;
+                }
+
+                if (moves < 0)
+                {
+                    std::sort(activeLines.begin(), activeLines.end(), [](const ActiveLine &a, const ActiveLine &b) { return a.x < b.x; });
+                }
+
+                int winding = 0;
+                float fill_start = 0;
+                bool filling = false;
+
+                for (const auto &line : activeLines)
+                {
+                    winding += line.edge.direction;
+
+                    bool should_fill = shouldFill(winding, windingRule);
+
+                    if (should_fill && !filling)
+                    {
+                        fill_start = line.x;
+                        filling = true;
                     }
-                    else
+                    else if (!should_fill && filling)
                     {
-                        int currentPoint = 0;
-                        for (const auto &line : fillLines)
+                        int x_start, x_end;
+                        if (toSpan(fill_start, line.x, sampling, x_start, x_end))
                         {
-                            for (int x = line.first.x; x <= line.second.x; x++)
-                            {
-                                image(x, line.first.y) = gradient.next(pointCount, currentPoint);
-                                currentPoint++;
-                            }
+                            emit(y, x_start, x_end);
                         }
+                        filling = false;
                     }
                 }
-                else
+            }
+        }
+
+        // Scans the visible rows of the edges, split into one band per thread under PARALLEL.
+        // emit(band, y, x_start, x_end) receives each span with the index of its band; bands are
+        // numbered top to bottom and rows inside a band arrive in order.
+        template <typename Emit>
+        int scanBands(const std::vector<Line> &lines, int height, WindingRule windingRule, Sampling sampling, parallel::Execution execution, Emit emit)
+        {
+            auto [y_min, y_max] = rowRange(lines, 0, height);
+
+            int rows = std::max(0, y_max - y_min);
+            int bands = execution == parallel::Execution::SERIAL ? 1 : std::max(1, std::min(parallel::threadCount(), rows));
+
+            parallel::forEach(bands, [&](int begin, int end)
+                              {
+                                  for (int band = begin; band < end; band++)
+                                  {
+                                      int y_begin = y_min + int((long long)rows * band / bands);
+                                      int y_end = y_min + int((long long)rows * (band + 1) / bands);
+
+                                      scanEdges(lines, y_begin, y_end, windingRule, sampling, [&](int y, int x_start, int x_end)
+                                                { emit(band, y, x_start, x_end); });
+                                  }
+                              },
+                              execution);
+
+            return bands;
+        }
+
+        template <typename Image, typename Color>
+        inline void fillSpan(Image &image, int y, int x_start, int x_end, Color color)
+        {
+            if (y < 0 || y >= image.GetHeight())
+            {
+                return;
+            }
+
+            x_start = std::max(x_start, 0);
+            x_end = std::min(x_end, image.GetWidth() - 1);
+
+            if (x_start <= x_end)
+            {
+                std::fill_n(&image(x_start, y), x_end - x_start + 1, color);
+            }
+        }
+
+        template <typename Image, typename FillColor>
+        void fillEdges(Image &image, const std::vector<Line> &lines, FillColor fillColor, WindingRule windingRule, Sampling sampling, parallel::Execution execution = parallel::Execution::SERIAL)
+        {
+            if constexpr (std::is_same_v<FillColor, gradient::StopGradient> ||
+                          std::is_same_v<FillColor, gradient::RGBStopGradient>)
+            {
+                // Stop gradients are placed in image coordinates, so spans are drawn as scanned
+                scanBands(lines, image.GetHeight(), windingRule, sampling, execution, [&](int /*band*/, int y, int x_start, int x_end)
+                          {
+                              x_start = std::max(x_start, 0);
+                              x_end = std::min(x_end, image.GetWidth() - 1);
+
+                              if (x_start <= x_end)
+                              {
+                                  fillColor.atSpan(&image(x_start, y), x_start, y, x_end - x_start + 1);
+                              }
+                          });
+            }
+            else if constexpr (std::is_same_v<FillColor, gradient::Gradient> ||
+                               std::is_same_v<FillColor, gradient::RGBGradient>)
+            {
+                if (lines.empty())
                 {
-                    for (const auto &line : fillLines)
-                    {
-                        line::drawLine(image, line.first, line.second, fillColor.value());
-                    }
+                    return;
+                }
+
+                float x_min = lines[0].x, x_max = lines[0].x;
+                int y_min = lines[0].y_min, y_max = lines[0].y_max;
+
+                std::vector<Point> vertices;
+                vertices.reserve(2 * lines.size());
+
+                for (const auto &line : lines)
+                {
+                    float x_end = line.x + line.slope_inverse * (line.y_max - line.y_min);
+
+                    x_min = std::min(x_min, std::min(line.x, x_end));
+                    x_max = std::max(x_max, std::max(line.x, x_end));
+                    y_min = std::min(y_min, line.y_min);
+                    y_max = std::max(y_max, line.y_max);
+
+                    vertices.push_back({int(std::round(line.x)), line.y_min});
+                    vertices.push_back({int(std::round(x_end)), line.y_max});
+                }
+
+                Point center = {(int(std::round(x_min)) + int(std::round(x_max))) / 2, (y_min + y_max) / 2};
+
+                FillColor gradient = fillColor;
+
+                // Directional gradients take their range from the edge endpoints, so spans are
+                // drawn as soon as they are scanned
+                if (gradient.isDirectional())
+                {
+                    gradient.prepareDirectional(center, vertices);
+
+                    scanBands(lines, image.GetHeight(), windingRule, sampling, execution, [&](int /*band*/, int y, int x_start, int x_end)
+                              {
+                                  x_start = std::max(x_start, 0);
+                                  x_end = std::min(x_end, image.GetWidth() - 1);
+
+                                  if (x_start <= x_end)
+                                  {
+                                      gradient.atSpan(&image(x_start, y), x_start, y, x_end - x_start + 1);
+                                  }
+                              });
+                    return;
+                }
+
+                // Sequential gradients need every span before drawing to count the pixels. Each
+                // band collects its own spans and the bands are joined in row order.
+                std::vector<std::vector<std::pair<Point, Point>>> bandLines(execution == parallel::Execution::SERIAL ? 1 : parallel::threadCount());
+
+                int bands = scanBands(lines, image.GetHeight(), windingRule, sampling, execution, [&](int band, int y, int x_start, int x_end)
+                                      { bandLines[band].push_back({{x_start, y}, {x_end, y}}); });
+
+                std::vector<std::pair<Point, Point>> fillLines;
+
+                for (int band = 0; band < bands; band++)
+                {
+                    fillLines.insert(fillLines.end(), bandLines[band].begin(), bandLines[band].end());
+                }
+
+                // First sequence index of every span
+                std::vector<int> firstPoint(fillLines.size());
+                int pointCount = 0;
+
+                for (int i = 0; i < (int)fillLines.size(); i++)
+                {
+                    firstPoint[i] = pointCount;
+                    pointCount += fillLines[i].second.x - fillLines[i].first.x + 1;
                 }
+
+                // The sequence runs over the visible rows only: addEdges drops edges above and
+                // below the image, so rows clipped off vertically are not counted. Within a row,
+                // pixels clipped off either side still advance it, so a polygon moved sideways
+                // keeps its colours.
+                parallel::forEach(fillLines.size(), [&](int begin, int end)
+                                  {
+                                      for (int i = begin; i < end; i++)
+                                      {
+                                          const auto &line = fillLines[i];
+                                          int x_start = std::max(line.first.x, 0);
+                                          int x_end = std::min(line.second.x, image.GetWidth() - 1);
+
+                                          if (x_start <= x_end)
+                                          {
+                                              gradient.nextSpan(&image(x_start, line.first.y), pointCount, firstPoint[i] + x_start - line.first.x, x_end - x_start + 1, x_start, line.first.y);
+                                          }
+                                      }
+                                  },
+                                  execution);
+            }
+            else
+            {
+                scanBands(lines, image.GetHeight(), windingRule, sampling, execution, [&](int /*band*/, int y, int x_start, int x_end)
+                          { fillSpan(image, y, x_start, x_end, fillColor); });
+            }
+        }
+
+        template <typename Image, typename FillColor>
+        void fillPolygon(Image &image, const std::vector<curve::FloatPoint> &points, FillColor fillColor, WindingRule windingRule, parallel::Execution execution)
+        {
+            std::vector<Line> lines;
+
+            addEdges(lines, points, image.GetHeight());
+
+            fillEdges(image, lines, fillColor, windingRule, Sampling::PIXEL_CENTER, execution);
+        }
+
+        template <typename Image, typename OutlineColor, typename FillColor>
+        void drawPolygon(Image &image, const std::vector<Point> &points, OutlineColor outlineColor, std::optional<FillColor> fillColor, bool skipOutline, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+        {
+            int n = points.size();
+
+            if (fillColor.has_value())
+            {
+                std::vector<__detail::Line> lines;
+
+                addEdges(lines, points, image.GetHeight());
+
+                fillEdges(image, lines, fillColor.value(), windingRule, Sampling::ROUNDED, execution);
             }
 
             if (!skipOutline)
@@ -198,22 +487,28 @@ namespace polygon
     }
 
     // Custom outline, solid fill
-    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, Byte outlineColor, Byte fillColor, WindingRule windingRule = WindingRule::ODD)
+    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, Byte outlineColor, Byte fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
     {
         bool skipOutline = (outlineColor == fillColor);
-        __detail::drawPolygon(image, points, outlineColor, std::optional<Byte>(fillColor), skipOutline, windingRule);
+        __detail::drawPolygon(image, points, outlineColor, std::optional<Byte>(fillColor), skipOutline, windingRule, execution);
     }
 
     // Custom outline, gradient fill
-    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, Byte outlineColor, gradient::Gradient fillColor, WindingRule windingRule = WindingRule::ODD)
+    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, Byte outlineColor, gradient::Gradient fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
     {
-        __detail::drawPolygon(image, points, outlineColor, std::optional<gradient::Gradient>(fillColor), false, windingRule);
+        __detail::drawPolygon(image, points, outlineColor, std::optional<gradient::Gradient>(fillColor), false, windingRule, execution);
     }
 
     // Gradient fill only, no outline
-    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, gradient::Gradient fillColor, WindingRule windingRule = WindingRule::ODD)
+    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, gradient::Gradient fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
     {
-        __detail::drawPolygon(image, points, 0, std::optional<gradient::Gradient>(fillColor), true, windingRule);
+        __detail::drawPolygon(image, points, 0, std::optional<gradient::Gradient>(fillColor), true, windingRule, execution);
+    }
+
+    // Stop gradient fill only, no outline
+    inline void drawPolygon(GrayscaleImage &image, const std::vector<Point> &points, const gradient::StopGradient &fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::drawPolygon(image, points, 0, std::optional<gradient::StopGradient>(fillColor), true, windingRule, execution);
     }
 
     // ========== ColorImage ==========
@@ -230,21 +525,330 @@ namespace polygon
     }
 
     // Custom outline, solid fill
-    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, RGBA outlineColor, RGBA fillColor, WindingRule windingRule = WindingRule::ODD)
+    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, RGBA outlineColor, RGBA fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
     {
         bool skipOutline = (outlineColor.r == fillColor.r && outlineColor.g == fillColor.g && outlineColor.b == fillColor.b);
-        __detail::drawPolygon(image, points, outlineColor, std::optional<RGBA>(fillColor), skipOutline, windingRule);
+        __detail::drawPolygon(image, points, outlineColor, std::optional<RGBA>(fillColor), skipOutline, windingRule, execution);
     }
 
     // Custom outline, gradient fill (never skip outline)
-    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, RGBA outlineColor, gradient::RGBGradient fillColor, WindingRule windingRule = WindingRule::ODD)
+    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, RGBA outlineColor, gradient::RGBGradient fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
     {
-        __detail::drawPolygon(image, points, outlineColor, std::optional<gradient::RGBGradient>(fillColor), false, windingRule);
+        __detail::drawPolygon(image, points, outlineColor, std::optional<gradient::RGBGradient>(fillColor), false, windingRule, execution);
     }
 
     // Gradient fill only, no outline
-    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, gradient::RGBGradient fillColor, WindingRule windingRule = WindingRule::ODD)
+    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, gradient::RGBGradient fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::drawPolygon(image, points, RGBA(0, 0, 0), std::optional<gradient::RGBGradient>(fillColor), true, windingRule, execution);
+    }
+
+    // Stop gradient fill only, no outline
+    inline void drawPolygon(ColorImage &image, const std::vector<Point> &points, const gradient::RGBStopGradient &fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::drawPolygon(image, points, RGBA(0, 0, 0), std::optional<gradient::RGBStopGradient>(fillColor), true, windingRule, execution);
+    }
+
+    // ========== Sub-pixel vertices ==========
+    // Fills without an outline, sampling pixel centres under the top-left rule: polygons that share
+    // an edge (tiles, meshes) meet without gaps or double-filled pixels
+
+    inline void fillPolygon(GrayscaleImage &image, const std::vector<curve::FloatPoint> &points, Byte fillColor = 255, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillPolygon(image, points, fillColor, windingRule, execution);
+    }
+
+    inline void fillPolygon(GrayscaleImage &image, const std::vector<curve::FloatPoint> &points, gradient::Gradient fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillPolygon(image, points, fillColor, windingRule, execution);
+    }
+
+    inline void fillPolygon(GrayscaleImage &image, const std::vector<curve::FloatPoint> &points, const gradient::StopGradient &fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillPolygon(image, points, fillColor, windingRule, execution);
+    }
+
+    inline void fillPolygon(ColorImage &image, const std::vector<curve::FloatPoint> &points, RGBA fillColor = RGBA(255, 255, 255), WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillPolygon(image, points, fillColor, windingRule, execution);
+    }
+
+    inline void fillPolygon(ColorImage &image, const std::vector<curve::FloatPoint> &points, gradient::RGBGradient fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillPolygon(image, points, fillColor, windingRule, execution);
+    }
+
+    inline void fillPolygon(ColorImage &image, const std::vector<curve::FloatPoint> &points, const gradient::RGBStopGradient &fillColor, WindingRule windingRule = WindingRule::ODD, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        __detail::fillPolygon(image, points, fillColor, windingRule, execution);
+    }
+
+    // Fills many polygons with solid colors in one top-to-bottom sweep over a shared edge table.
+    // Polygons are painted in the order they were added, later ones over earlier ones. The edge
+    // and scanline buffers are kept between draws, so a batch reused across tiles or frames stops
+    // allocating once it has seen its largest input.
+    template <typename Color>
+    class Batch
+    {
+    public:
+        explicit Batch(WindingRule windingRule = WindingRule::ODD) : windingRule(windingRule) {}
+
+        void add(const std::vector<Point> &points, Color color)
+        {
+            int polygon = colors.size();
+
+            colors.push_back(color);
+            samplings.push_back(__detail::Sampling::ROUNDED);
+
+            __detail::addEdges(lines, points, std::numeric_limits<int>::max());
+            owners.resize(lines.size(), polygon);
+        }
+
+        // Sub-pixel polygons follow the top-left rule of polygon::fillPolygon
+        void add(const std::vector<curve::FloatPoint> &points, Color color)
+        {
+            int polygon = colors.size();
+
+            colors.push_back(color);
+            samplings.push_back(__detail::Sampling::PIXEL_CENTER);
+
+            __detail::addEdges(lines, points, std::numeric_limits<int>::max());
+            owners.resize(lines.size(), polygon);
+        }
+
+        // Forgets the polygons but keeps the buffers for the next batch
+        void clear()
+        {
+            lines.clear();
+            owners.clear();
+            colors.clear();
+            samplings.clear();
+        }
+
+        int size() const { return colors.size(); }
+
+        template <typename Image>
+        void draw(Image &image)
+        {
+            int height = image.GetHeight();
+            int y_min = height, y_max = 0;
+
+            for (const auto &line : lines)
+            {
+                if (line.y_max > 0 && line.y_min < height)
+                {
+                    y_min = std::min(y_min, std::max(line.y_min, 0));
+                    y_max = std::max(y_max, std::min(line.y_max, height));
+                }
+            }
+
+            if (y_min >= y_max)
+            {
+                return;
+            }
+
+            buckets.assign(y_max - y_min + 2, 0);
+
+            for (const auto &line : lines)
+            {
+                if (line.y_max > 0 && line.y_min < height)
+                {
+                    buckets[std::max(line.y_min, 0) - y_min + 1]++;
+                }
+            }
+
+            for (int i = 1; i < (int)buckets.size(); i++)
+            {
+                buckets[i] += buckets[i - 1];
+            }
+
+            edgeTable.resize(buckets.back());
+
+            for (int i = 0; i < (int)lines.size(); i++)
+            {
+                const __detail::Line &line = lines[i];
+
+                if (line.y_max > 0 && line.y_min < height)
+                {
+                    int y_start = std::max(line.y_min, 0);
+
+                    edgeTable[buckets[y_start - y_min]++] = {__detail::edgeX(line, y_start), line, owners[i]};
+                }
+            }
+
+            activeLines.clear();
+
+            // Active edges are kept ordered by polygon, then x, so each polygon's crossings are
+            // contiguous and polygons come out in painting order
+            auto before = [](const BatchLine &a, const BatchLine &b)
+            {
+                return a.polygon < b.polygon || (a.polygon == b.polygon && a.x < b.x);
+            };
+
+            int nextLine = 0;
+
+            for (int y = y_min; y < y_max; y++)
+            {
+                int firstNew = activeLines.size();
+
+                while (nextLine < (int)edgeTable.size() && std::max(edgeTable[nextLine].edge.y_min, 0) == y)
+                {
+                    activeLines.push_back(edgeTable[nextLine++]);
+                }
+
+                // Only crossings within a polygon reorder the existing edges, and the new edges come
+                // out of the edge table in polygon order, so both runs are already grouped by polygon
+                // and nearly sorted within each group. Each polygon's edges get the same insertion
+                // sort and move budget as scanEdges, falling back to a full sort of just that polygon
+                // when its outline crosses itself on this row.
+                auto sortRuns = [&](int first, int last)
+                {
+                    for (int begin = first; begin < last;)
+                    {
+                        int end = begin + 1;
+
+                        while (end < last && activeLines[end].polygon == activeLines[begin].polygon)
+                        {
+                            end++;
+                        }
+
+                        int moves = 4 * (end - begin);
+
+                        for (int i = begin + 1; i < end && moves >= 0; i++)
+                        {
+                            BatchLine line = activeLines[i];
+                            int j = i - 1;
+
+                            while (j >= begin && activeLines[j].x > line.x)
+                            {
+                                activeLines[j + 1] = activeLines[j];
+                                j--;
+                                moves--;
+                            }
+
+                            activeLines[j + 1] = line;
+                        }
+
+                        if (moves < 0)
+                        {
+                            std::sort(activeLines.begin() + begin, activeLines.begin() + end, [](const BatchLine &a, const BatchLine &b) { return a.x < b.x; });
+                        }
+
+                        begin = end;
+                    }
+                };
+
+                sortRuns(0, firstNew);
+
+                if (firstNew < (int)activeLines.size())
+                {
+                    sortRuns(firstNew, activeLines.size());
+
+                    merged.resize(activeLines.size());
+                    std::merge(activeLines.begin(), activeLines.begin() + firstNew, activeLines.begin() + firstNew, activeLines.end(), merged.begin(), before);
+                    activeLines.swap(merged);
+                }
+
+                int winding = 0;
+                float fill_start = 0;
+                bool filling = false;
+
+                for (int i = 0; i < (int)activeLines.size(); i++)
+                {
+                    const BatchLine &line = activeLines[i];
+
+                    winding += line.edge.direction;
+
+                    bool should_fill = __detail::shouldFill(winding, windingRule);
+
+                    if (should_fill && !filling)
+                    {
+                        fill_start = line.x;
+                        filling = true;
+                    }
+                    else if (!should_fill && filling)
+                    {
+                        int x_start, x_end;
+                        if (__detail::toSpan(fill_start, line.x, samplings[line.polygon], x_start, x_end))
+                        {
+                            __detail::fillSpan(image, y, x_start, x_end, colors[line.polygon]);
+                        }
+                        filling = false;
+                    }
+
+                    if (i + 1 == (int)activeLines.size() || activeLines[i + 1].polygon != line.polygon)
+                    {
+                        winding = 0;
+                        filling = false;
+                    }
+                }
+
+                // Advance the edges to the next row and drop the ones that end there in the same pass
+                int kept = 0;
+
+                for (auto &line : activeLines)
+                {
+                    if (line.edge.y_max != y + 1)
+                    {
+                        line.x = __detail::edgeX(line.edge, y + 1);
+                        activeLines[kept++] = line;
+                    }
+                }
+
+                activeLines.resize(kept);
+            }
+        }
+
+    private:
+        struct BatchLine
+        {
+            float x;
+            __detail::Line edge;
+            int polygon;
+        };
+
+        WindingRule windingRule;
+        std::vector<Color> colors;
+        std::vector<__detail::Sampling> samplings;
+        std::vector<__detail::Line> lines;
+        std::vector<int> owners, buckets;
+        std::vector<BatchLine> edgeTable, activeLines, merged;
+    };
+
+    // Fills polygons[i] with colors[i], later polygons over earlier ones
+    inline void drawPolygons(GrayscaleImage &image, const std::vector<std::vector<Point>> &polygons, const std::vector<Byte> &colors, WindingRule windingRule = WindingRule::ODD)
     {
-        __detail::drawPolygon(image, points, RGBA(0, 0, 0), std::optional<gradient::RGBGradient>(fillColor), true, windingRule);
+        if (colors.size() != polygons.size())
+        {
+            std::cerr << "Each polygon needs exactly one color." << std::endl;
+            return;
+        }
+
+        Batch<Byte> batch(windingRule);
+
+        for (int i = 0; i < (int)polygons.size(); i++)
+        {
+            batch.add(polygons[i], colors[i]);
+        }
+
+        batch.draw(image);
+    }
+
+    inline void drawPolygons(ColorImage &image, const std::vector<std::vector<Point>> &polygons, const std::vector<RGBA> &colors, WindingRule windingRule = WindingRule::ODD)
+    {
+        if (colors.size() != polygons.size())
+        {
+            std::cerr << "Each polygon needs exactly one color." << std::endl;
+            return;
+        }
+
+        Batch<RGBA> batch(windingRule);
+
+        for (int i = 0; i < (int)polygons.size(); i++)
+        {
+            batch.add(polygons[i], colors[i]);
+        }
+
+        batch.draw(image);
     }
 }
@@ -0,0 +1,359 @@
+#pragma once
+
+#include "Image.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace resize
+{
+    enum class Method
+    {
+        NEAREST = 0,
+        BOX,      // mean of the source pixels under each target pixel
+        BILINEAR, // triangle
+        BICUBIC,  // Catmull-Rom, a = -0.5
+        LANCZOS3
+    };
+
+    namespace __detail
+    {
+        constexpr int BLOCK = 16;
+
+        // How far the kernel reaches either side, in source pixels at scale 1
+        inline float support(Method method)
+        {
+            switch (method)
+            {
+            case Method::BOX:
+                return 0.5f;
+            case Method::BILINEAR:
+                return 1.0f;
+            case Method::BICUBIC:
+                return 2.0f;
+            case Method::LANCZOS3:
+                return 3.0f;
+            case Method::NEAREST:
+            default:
+                return 0.0f;
+            }
+        }
+
+        inline float sinc(float x)
+        {
+            if (x == 0)
+            {
+                return 1.0f;
+            }
+
+            x *= (float)M_PI;
+            return std::sin(x) / x;
+        }
+
+        inline float kernel(Method method, float x)
+        {
+            x = std::abs(x);
+
+            switch (method)
+            {
+            case Method::BOX:
+                return x < 0.5f ? 1.0f : 0.0f;
+            case Method::BILINEAR:
+                return std::max(1.0f - x, 0.0f);
+            case Method::BICUBIC:
+            {
+                const float a = -0.5f;
+
+                if (x < 1)
+                {
+                    return ((a + 2) * x - (a + 3)) * x * x + 1;
+                }
+
+                return x < 2 ? ((a * x - 5 * a) * x + 8 * a) * x - 4 * a : 0.0f;
+            }
+            case Method::LANCZOS3:
+                return x < 3 ? sinc(x) * sinc(x / 3) : 0.0f;
+            case Method::NEAREST:
+            default:
+                return 1.0f;
+            }
+        }
+
+        // Source position of target edge i, exact for whole ratios
+        inline double footprint(int i, int in, int out)
+        {
+            return (double)i * in / out;
+        }
+
+        // How much of source pixel j lies under target pixel i. Box weights are areas rather than
+        // kernel samples, so a source pixel straddling two target pixels is shared between them.
+        inline float coverage(int j, int i, int in, int out)
+        {
+            return static_cast<float>(std::max(std::min(j + 1.0, footprint(i + 1, in, out)) - std::max((double)j, footprint(i, in, out)), 0.0));
+        }
+
+        // Output sample i of a line is the dot product of `size` weights starting at
+        // weights[i * size] with the source samples starting at first[i]. Every output sample
+        // gets the same count, zero padded, so the passes have no per sample bounds.
+        struct Taps
+        {
+            int size = 0;
+            std::vector<int> first;
+            std::vector<float> weights;
+        };
+
+        // Source pixel j covers [j, j + 1) and target pixel i covers [i, i + 1) * scale. When
+        // shrinking, the kernel is stretched by the scale so every source pixel is weighed in;
+        // a box weighs each by how much of it the target covers. Weights falling outside the
+        // source are dropped and the rest renormalized.
+        inline Taps taps(int in, int out, Method method)
+        {
+            float scale = (float)in / out, stretch = std::max(scale, 1.0f);
+            float reach = support(method) * stretch;
+
+            std::vector<int> lo(out), hi(out);
+            Taps taps;
+
+            for (int i = 0; i < out; i++)
+            {
+                float center = (i + 0.5f) * scale;
+
+                if (method == Method::NEAREST)
+                {
+                    lo[i] = std::min((int)center, in - 1);
+                    hi[i] = lo[i] + 1;
+                }
+                else if (method == Method::BOX)
+                {
+                    lo[i] = std::min((int)std::floor(footprint(i, in, out)), in - 1);
+                    hi[i] = std::max(std::min((int)std::ceil(footprint(i + 1, in, out)), in), lo[i] + 1);
+                }
+                else
+                {
+                    lo[i] = std::max((int)std::ceil(center - reach - 0.5f), 0);
+                    hi[i] = std::max(std::min((int)std::floor(center + reach - 0.5f) + 1, in), lo[i] + 1);
+                    lo[i] = std::min(lo[i], in - 1);
+                }
+
+                taps.size = std::max(taps.size, hi[i] - lo[i]);
+            }
+
+            taps.size = std::min(taps.size, in);
+            taps.first.resize(out);
+            taps.weights.assign(out * taps.size, 0.0f);
+
+            for (int i = 0; i < out; i++)
+            {
+                float center = (i + 0.5f) * scale;
+                float *weights = &taps.weights[i * taps.size];
+
+                taps.first[i] = std::min(lo[i], in - taps.size);
+
+                float total = 0;
+
+                for (int j = lo[i]; j < hi[i]; j++)
+                {
+                    float weight = method == Method::NEAREST ? 1.0f
+                                   : method == Method::BOX   ? coverage(j, i, in, out)
+                                                             : kernel(method, (j + 0.5f - center) / stretch);
+
+                    weights[j - taps.first[i]] = weight;
+                    total += weight;
+                }
+
+                if (total == 0)
+                {
+                    // Only possible at a kernel zero crossing: fall back to the nearest pixel
+                    weights[std::min(std::max((int)center, taps.first[i]), taps.first[i] + taps.size - 1) - taps.first[i]] = total = 1.0f;
+                }
+
+                for (int k = 0; k < taps.size; k++)
+                {
+                    weights[k] /= total;
+                }
+            }
+
+            return taps;
+        }
+
+        inline Byte toByte(float value)
+        {
+            return static_cast<int>(std::min(std::max(value + 0.5f, 0.0f), 255.0f));
+        }
+
+        // Rows first into a float buffer of CHANNELS interleaved values per pixel, only for the
+        // source rows the columns pass reads; then columns, a whole block of values at a time,
+        // rounded to bytes in the same block. load(y, line) fills source row y with floats and
+        // store(y, bytes) takes target row y.
+        template <int CHANNELS, typename Load, typename Store>
+        void resample(int inWidth, int inHeight, int outWidth, int outHeight, Method method, parallel::Execution execution, Load load, Store store)
+        {
+            Taps across = taps(inWidth, outWidth, method), down = taps(inHeight, outHeight, method);
+
+            int top = down.first.front(), bottom = down.first.back() + down.size;
+            int values = outWidth * CHANNELS, stride = (values + BLOCK - 1) / BLOCK * BLOCK;
+
+            std::vector<float> rows((bottom - top) * stride, 0.0f);
+
+            parallel::forEach(bottom - top, [&](int begin, int end)
+                              {
+                                  std::vector<float> line(inWidth * CHANNELS);
+
+                                  for (int r = begin; r < end; r++)
+                                  {
+                                      load(top + r, line.data());
+
+                                      float *out = &rows[r * stride];
+
+                                      for (int x = 0; x < outWidth; x++)
+                                      {
+                                          const float *in = &line[across.first[x] * CHANNELS];
+                                          const float *weights = &across.weights[x * across.size];
+
+                                          float sum[CHANNELS] = {};
+
+                                          for (int k = 0; k < across.size; k++)
+                                          {
+                                              for (int c = 0; c < CHANNELS; c++)
+                                              {
+                                                  sum[c] += weights[k] * in[k * CHANNELS + c];
+                                              }
+                                          }
+
+                                          std::copy_n(sum, CHANNELS, out + x * CHANNELS);
+                                      }
+                                  }
+                              },
+                              execution);
+
+            parallel::forEach(outHeight, [&](int begin, int end)
+                              {
+                                  std::vector<Byte> row(stride);
+
+                                  for (int y = begin; y < end; y++)
+                                  {
+                                      const float *weights = &down.weights[y * down.size];
+                                      const float *in = &rows[(down.first[y] - top) * stride];
+
+                                      for (int x = 0; x < stride; x += BLOCK)
+                                      {
+                                          float sum[BLOCK] = {};
+
+                                          for (int k = 0; k < down.size; k++)
+                                          {
+                                              const float *source = in + k * stride + x;
+
+                                              for (int j = 0; j < BLOCK; j++)
+                                              {
+                                                  sum[j] += weights[k] * source[j];
+                                              }
+                                          }
+
+                                          Byte bytes[BLOCK];
+
+                                          for (int j = 0; j < BLOCK; j++)
+                                          {
+                                              bytes[j] = toByte(sum[j]);
+                                          }
+
+                                          std::copy_n(bytes, BLOCK, &row[x]);
+                                      }
+
+                                      store(y, row.data());
+                                  }
+                              },
+                              execution);
+        }
+
+        inline bool valid(int inWidth, int inHeight, int width, int height)
+        {
+            if (width <= 0 || height <= 0)
+            {
+                std::cerr << "Resize target must be at least 1x1." << std::endl;
+                return false;
+            }
+
+            if (inWidth <= 0 || inHeight <= 0)
+            {
+                std::cerr << "Cannot resize an empty image." << std::endl;
+                return false;
+            }
+
+            return true;
+        }
+    }
+
+    inline GrayscaleImage resize(const GrayscaleImage &image, int width, int height, Method method = Method::BILINEAR, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        if (!__detail::valid(image.GetWidth(), image.GetHeight(), width, height))
+        {
+            return GrayscaleImage();
+        }
+
+        GrayscaleImage result(width, height);
+
+        __detail::resample<1>(
+            image.GetWidth(), image.GetHeight(), width, height, method, execution,
+            [&](int y, float *line)
+            {
+                for (int x = 0; x < image.GetWidth(); x++)
+                {
+                    line[x] = image(x, y);
+                }
+            },
+            [&](int y, const Byte *levels)
+            { std::copy_n(levels, width, &result(0, y)); });
+
+        return result;
+    }
+
+    // Pixels are written as their four channel bytes in a row
+    static_assert(sizeof(RGBA) == 4, "RGBA must be four packed bytes");
+
+    inline ColorImage resize(const ColorImage &image, int width, int height, Method method = Method::BILINEAR, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        if (!__detail::valid(image.GetWidth(), image.GetHeight(), width, height))
+        {
+            return ColorImage();
+        }
+
+        ColorImage result(width, height);
+
+        __detail::resample<4>(
+            image.GetWidth(), image.GetHeight(), width, height, method, execution,
+            [&](int y, float *line)
+            {
+                for (int x = 0; x < image.GetWidth(); x++)
+                {
+                    RGBA pixel = image(x, y);
+
+                    line[4 * x] = pixel.r;
+                    line[4 * x + 1] = pixel.g;
+                    line[4 * x + 2] = pixel.b;
+                    line[4 * x + 3] = pixel.a;
+                }
+            },
+            [&](int y, const Byte *channels)
+            { std::memcpy(&result(0, y), channels, width * sizeof(RGBA)); });
+
+        return result;
+    }
+
+    // The image, then halves of it down to 1x1. An odd side rounds down.
+    template <typename Image>
+    std::vector<Image> mipmaps(const Image &image, Method method = Method::BOX, parallel::Execution execution = parallel::Execution::SERIAL)
+    {
+        std::vector<Image> levels = {image};
+
+        while (levels.back().GetWidth() > 1 || levels.back().GetHeight() > 1)
+        {
+            const Image &last = levels.back();
+            levels.push_back(resize(last, std::max(last.GetWidth() / 2, 1), std::max(last.GetHeight() / 2, 1), method, execution));
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,59 @@
+#include "../../Image.h"
+#include "../../Color.h"
+#include <optional>
+
+// The same "over" operator as over.cpp, but with the color channels mixed in linear light, so
+// soft edges and half-transparent layers keep their brightness instead of darkening
+std::optional<ColorImage> blendImages(const ColorImage &original, const ColorImage &secondary)
+{
+    int height = original.GetHeight();
+    int width = original.GetWidth();
+
+    if (height != secondary.GetHeight() || width != secondary.GetWidth())
+    {
+        std::cerr << "Both images must have the same width and height" << std::endl;
+        return std::nullopt;
+    }
+
+    LinearPlanes back = color::toLinear(original, parallel::Execution::PARALLEL);
+    LinearPlanes front = color::toLinear(secondary, parallel::Execution::PARALLEL);
+
+    for (int i = 0; i < width * height; i++)
+    {
+        float af = front.alpha[i] / 255.0f;
+        float ab = back.alpha[i] / 255.0f * (1 - af);
+
+        float a = af + ab;
+        float scale = a > 0.0f ? 1 / a : 0.0f;
+
+        back.r[i] = (back.r[i] * ab + front.r[i] * af) * scale;
+        back.g[i] = (back.g[i] * ab + front.g[i] * af) * scale;
+        back.b[i] = (back.b[i] * ab + front.b[i] * af) * scale;
+        back.alpha[i] = static_cast<Byte>(a * 255 + 0.5f);
+    }
+
+    return color::toRGBA(back, parallel::Execution::PARALLEL);
+}
+
+int main()
+{
+    ColorImage original, secondary;
+
+    original.Load("original.png");
+
+    secondary.Load("secondary.png");
+
+    auto blended_result = blendImages(original, secondary);
+
+    if (!blended_result.has_value())
+    {
+        std::cerr << "Failed to blend images" << std::endl;
+        return 1;
+    }
+
+    ColorImage blended = std::move(blended_result.value());
+
+    blended.Save("blended-linear.png");
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "../Image.h"
+#include "../Blur.h"
+#include "../Polygon.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// Box blurs of growing radius cost the same, where the convolution they replace grows with the
+// radius. The second half draws a star with a soft drop shadow: the star's mask, offset and
+// blurred, darkens the background before the star itself is filled on top.
+int main()
+{
+    ColorImage image(1920, 1080);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            image(x, y) = ((x / 60 + y / 60) % 2) ? RGBA(235, 230, 220) : RGBA(200, 205, 215);
+        }
+    }
+
+    GrayscaleImage gray(image);
+
+    auto timed = [](const std::string &name, auto operation)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        operation();
+
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << name << " " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    };
+
+    for (int radius : {2, 16, 64})
+    {
+        timed("box radius " + std::to_string(radius), [&]
+              { blur::box(gray, radius); });
+        timed("convolution radius " + std::to_string(radius), [&]
+              { filter::filter(gray, filter::Separable::box(radius)); });
+    }
+
+    std::vector<curve::FloatPoint> star, shadow;
+
+    for (int i = 0; i < 10; i++)
+    {
+        float angle = i * (float)M_PI / 5 - (float)M_PI / 2, radius = i % 2 ? 180.0f : 420.0f;
+
+        star.push_back({960 + radius * std::cos(angle), 540 + radius * std::sin(angle)});
+        shadow.push_back({star.back().x + 40, star.back().y + 50});
+    }
+
+    GrayscaleImage mask(image.GetWidth(), image.GetHeight());
+    polygon::fillPolygon(mask, shadow, 255);
+
+    GrayscaleImage soft;
+
+    timed("shadow gaussian sigma 16", [&]
+          { soft = blur::gaussian(mask, 16.0f, filter::Border::CLAMP, parallel::Execution::PARALLEL); });
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            float shade = 1.0f - 0.6f * soft(x, y) / 255.0f;
+            RGBA color = image(x, y);
+
+            image(x, y) = RGBA((Byte)(color.r * shade), (Byte)(color.g * shade), (Byte)(color.b * shade));
+        }
+    }
+
+    polygon::fillPolygon(image, star, RGBA(230, 160, 40), polygon::WindingRule::ODD, parallel::Execution::PARALLEL);
+
+    image.Save("drop-shadow.png");
+    blur::gaussian(image, 6.0f, filter::Border::MIRROR, parallel::Execution::PARALLEL).Save("drop-shadow-blurred.png");
+
+    return 0;
+}
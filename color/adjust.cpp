@@ -0,0 +1,45 @@
+#include "../Image.h"
+#include "../Color.h"
+#include <chrono>
+#include <iostream>
+
+// A hue sweep across, lightness down, before and after a grade: hue turned back 15 degrees,
+// more saturation, lifted shadows and a little extra contrast
+int main()
+{
+    ColorImage image(720, 256);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            HSL pixel;
+            pixel.hue = x / 2.0f;
+            pixel.saturation = 0.8f;
+            pixel.lightness = 1.0f - y / 255.0f;
+
+            image(x, y) = color::toRGBA(pixel);
+        }
+    }
+
+    image.Save("original.png");
+
+    color::Adjustments grade;
+    grade.hue(-15.0f)
+        .saturation(1.25f)
+        .lightness([](float lightness)
+                   { return 0.1f + 0.9f * std::sqrt(lightness); })
+        .contrast(1.15f);
+
+    auto start = std::chrono::steady_clock::now();
+
+    grade.apply(image, parallel::Execution::PARALLEL);
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "graded in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    image.Save("adjusted.png");
+
+    return 0;
+}
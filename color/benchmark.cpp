@@ -0,0 +1,104 @@
+#include "../Image.h"
+#include "../Color.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+// Round trips a noisy 1920x1080 image through each color space, once pixel by pixel with the
+// scalar functions and once with the whole-image planar conversions
+template <typename Pixel, typename Planes>
+void benchmark(const char *name, const ColorImage &image, int frames)
+{
+    int width = image.GetWidth(), height = image.GetHeight();
+
+    ColorImage result(width, height);
+    std::vector<Pixel> pixels(width * height);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                Pixel pixel;
+
+                if constexpr (std::is_same_v<Pixel, HSL>)
+                    pixel = color::toHSL(image(x, y));
+                else if constexpr (std::is_same_v<Pixel, HSV>)
+                    pixel = color::toHSV(image(x, y));
+                else
+                    pixel = color::toHSI(image(x, y));
+
+                pixels[y * width + x] = pixel;
+            }
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                result(x, y) = color::toRGBA(pixels[y * width + x]);
+            }
+        }
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+
+    Planes planes;
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        if constexpr (std::is_same_v<Pixel, HSL>)
+            planes = color::toHSL(image);
+        else if constexpr (std::is_same_v<Pixel, HSV>)
+            planes = color::toHSV(image);
+        else
+            planes = color::toHSI(image);
+
+        result = color::toRGBA(planes);
+    }
+
+    auto planar = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        if constexpr (std::is_same_v<Pixel, HSL>)
+            planes = color::toHSL(image, parallel::Execution::PARALLEL);
+        else if constexpr (std::is_same_v<Pixel, HSV>)
+            planes = color::toHSV(image, parallel::Execution::PARALLEL);
+        else
+            planes = color::toHSI(image, parallel::Execution::PARALLEL);
+
+        result = color::toRGBA(planes, parallel::Execution::PARALLEL);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << name << ": per pixel " << std::chrono::duration<double, std::milli>(middle - start).count() / frames
+              << " ms, planar " << std::chrono::duration<double, std::milli>(planar - middle).count() / frames
+              << " ms, planar on " << parallel::threadCount() << " threads " << std::chrono::duration<double, std::milli>(end - planar).count() / frames << " ms" << std::endl;
+}
+
+int main()
+{
+    ColorImage image(1920, 1080);
+
+    std::mt19937 generator(1);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            unsigned int bits = generator();
+            image(x, y) = RGBA(bits & 255, (bits >> 8) & 255, (bits >> 16) & 255);
+        }
+    }
+
+    benchmark<HSL, HSLPlanes>("hsl", image, 10);
+    benchmark<HSV, HSVPlanes>("hsv", image, 10);
+    benchmark<HSI, HSIPlanes>("hsi", image, 10);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "../Image.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+// Converts a noisy 1920x1080 image to gray pixel by pixel through RGBA::luminance(), then with
+// the block kernel behind the GrayscaleImage constructor, serially and on every thread
+int main()
+{
+    ColorImage image(1920, 1080);
+
+    std::mt19937 generator(1);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            unsigned int bits = generator();
+            image(x, y) = RGBA(bits & 255, (bits >> 8) & 255, (bits >> 16) & 255);
+        }
+    }
+
+    const int frames = 20;
+
+    GrayscaleImage gray(image.GetWidth(), image.GetHeight());
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int y = 0; y < image.GetHeight(); y++)
+        {
+            for (int x = 0; x < image.GetWidth(); x++)
+            {
+                gray(x, y) = image(x, y).luminance();
+            }
+        }
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        gray = GrayscaleImage(image);
+    }
+
+    auto blocked = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        gray = GrayscaleImage(image, luma::Weights::REC601, parallel::Execution::PARALLEL);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "per pixel " << std::chrono::duration<double, std::milli>(middle - start).count() / frames
+              << " ms, blocks " << std::chrono::duration<double, std::milli>(blocked - middle).count() / frames
+              << " ms, blocks on " << parallel::threadCount() << " threads " << std::chrono::duration<double, std::milli>(end - blocked).count() / frames << " ms" << std::endl;
+
+    gray.Save("gray-601.png");
+    GrayscaleImage(image, luma::Weights::REC709).Save("gray-709.png");
+    ColorImage(gray, parallel::Execution::PARALLEL).Save("gray-expanded.png");
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "../Image.h"
+#include "../Color.h"
+#include "../Lut.h"
+#include <chrono>
+#include <iostream>
+
+// Bakes a grade into a 33-point 3D LUT, writes it as a .cube file and reads it back, then
+// compares applying the LUT with running the grade itself on a hue/lightness sweep
+int main()
+{
+    ColorImage image(720, 256);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            HSL pixel;
+            pixel.hue = x / 2.0f;
+            pixel.saturation = 0.8f;
+            pixel.lightness = 1.0f - y / 255.0f;
+
+            image(x, y) = color::toRGBA(pixel);
+        }
+    }
+
+    color::Adjustments grade;
+    grade.hue(-15.0f)
+        .saturation(1.25f)
+        .lightness([](float lightness)
+                   { return lightness + 0.3f * lightness * (1 - lightness); })
+        .value([](float value)
+               { return value * value * (3 - 2 * value); })
+        .contrast(1.15f);
+
+    lut::Lut3D::bake(33, grade).save("grade.cube");
+
+    lut::Lut3D lut;
+
+    if (!lut.load("grade.cube"))
+    {
+        return 1;
+    }
+
+    ColorImage graded = image;
+
+    auto start = std::chrono::steady_clock::now();
+
+    grade.apply(graded);
+
+    auto middle = std::chrono::steady_clock::now();
+
+    lut.apply(image);
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "grade " << std::chrono::duration<double, std::milli>(middle - start).count()
+              << " ms, lut " << std::chrono::duration<double, std::milli>(end - middle).count() << " ms" << std::endl;
+
+    graded.Save("graded.png");
+    image.Save("lut.png");
+
+    return 0;
+}
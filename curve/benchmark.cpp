@@ -0,0 +1,60 @@
+#include "../Image.h"
+#include "../Curve.h"
+#include <chrono>
+#include <random>
+
+template <int Degree>
+void benchmarkDegree(GrayscaleImage &image, std::mt19937 &generator, int count)
+{
+    std::uniform_int_distribution<int> coordinate(0, image.GetWidth() - 1);
+
+    std::vector<curve::BezierCurve<Degree>> curves(count);
+
+    for (auto &curve : curves)
+    {
+        for (Point &point : curve.points)
+        {
+            point = {coordinate(generator), coordinate(generator)};
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (const auto &curve : curves)
+    {
+        curve::drawCurve(image, curve);
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+
+    for (const auto &curve : curves)
+    {
+        curve::drawCurveUniform(image, curve);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Degree " << Degree << ": " << count << " curves, subdivision "
+              << std::chrono::duration<double, std::milli>(middle - start).count() << " ms, uniform "
+              << std::chrono::duration<double, std::milli>(end - middle).count() << " ms" << std::endl;
+}
+
+int main()
+{
+    GrayscaleImage image(1024, 1024);
+
+    std::mt19937 generator(42);
+
+    int count = 5000;
+
+    benchmarkDegree<3>(image, generator, count);
+    benchmarkDegree<4>(image, generator, count);
+    benchmarkDegree<5>(image, generator, count);
+    benchmarkDegree<6>(image, generator, count);
+    benchmarkDegree<7>(image, generator, count);
+    benchmarkDegree<8>(image, generator, count);
+
+    image.Save("curveBenchmark.png");
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "../Image.h"
+#include "../Filter.h"
+#include "../Noise.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// Blurs, differentiates and sharpens a 1920x1080 noise image with the filter module. The blur is
+// run both as a full 2D kernel and as its separable pair, which should look the same.
+int main()
+{
+    ColorImage image(1920, 1080);
+
+    noise::SimplexNoise simplexNoise(2024);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            float low = simplexNoise.noise(x * 0.005f, y * 0.005f), high = simplexNoise.noise(x * 0.08f, y * 0.08f);
+
+            image(x, y) = RGBA((Byte)std::round((0.8f * low + 0.2f * high + 1.0f) * 127.5f),
+                               (Byte)std::round((low + 1.0f) * 127.5f),
+                               (Byte)std::round((0.5f * high + 1.0f) * 127.5f));
+        }
+    }
+
+    GrayscaleImage gray(image);
+
+    auto timed = [](const char *name, auto operation)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        operation();
+
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << name << " " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    };
+
+    const parallel::Execution execution = parallel::Execution::PARALLEL;
+
+    GrayscaleImage blurred, separable, edges, laplacian;
+    ColorImage colorBlur;
+
+    timed("gaussian 9x9", [&]
+          { blurred = filter::filter(gray, filter::Kernel::gaussian(9, 2.0f), filter::Border::MIRROR, execution); });
+    timed("gaussian sigma 2 separable", [&]
+          { separable = filter::filter(gray, filter::Separable::gaussian(2.0f, 4), filter::Border::MIRROR, execution); });
+    timed("gaussian color", [&]
+          { colorBlur = filter::filter(image, filter::Separable::gaussian(2.0f), filter::Border::MIRROR, execution); });
+    timed("sobel", [&]
+          {
+              filter::Derivatives derivatives = filter::sobel(gray, 3, filter::Border::CLAMP, execution);
+              filter::Plane magnitude = derivatives.dx;
+
+              for (size_t i = 0; i < magnitude.values.size(); i++)
+              {
+                  magnitude.values[i] = std::hypot(derivatives.dx.values[i], derivatives.dy.values[i]);
+              }
+
+              edges = filter::toImage(magnitude, 0.25f, 0.0f, execution); });
+    timed("laplacian", [&]
+          { laplacian = filter::toImage(filter::convolve(gray, filter::Kernel::laplacian(3), filter::Border::CLAMP, execution), 2.0f, 128.0f, execution); });
+
+    gray.Save("filter-source.png");
+    blurred.Save("filter-gaussian.png");
+    separable.Save("filter-gaussian-separable.png");
+    colorBlur.Save("filter-gaussian-color.png");
+    edges.Save("filter-sobel.png");
+    laplacian.Save("filter-laplacian.png");
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "../Image.h"
+#include "../Gradient.h"
+#include <chrono>
+#include <iostream>
+
+// Full-image angled gradients, evaluated pixel by pixel through at(), a row at a time through
+// atSpan(), with fillGradient over parallel rows and with dithering. The first dithered fill
+// builds the blue-noise texture and is left out of the timing.
+template <typename Image, typename Gradient>
+void benchmark(const char *name, Gradient gradient, int frames)
+{
+    Image image(1920, 1080);
+
+    int width = image.GetWidth(), height = image.GetHeight();
+
+    gradient.prepareDirectional({width / 2, height / 2}, {{0, 0}, {width - 1, 0}, {0, height - 1}, {width - 1, height - 1}});
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                image(x, y) = gradient.at(x, y);
+            }
+        }
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            gradient.atSpan(&image(0, y), 0, y, width);
+        }
+    }
+
+    auto spans = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        gradient::fillGradient(image, gradient, parallel::Execution::PARALLEL);
+    }
+
+    auto filled = std::chrono::steady_clock::now();
+
+    gradient.setDither(dither::Pattern::BLUE_NOISE);
+    gradient::fillGradient(image, gradient);
+
+    auto dithered = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        gradient::fillGradient(image, gradient);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << name << ": per pixel " << std::chrono::duration<double, std::milli>(middle - start).count() / frames
+              << " ms, per span " << std::chrono::duration<double, std::milli>(spans - middle).count() / frames
+              << " ms, fillGradient on " << parallel::threadCount() << " threads " << std::chrono::duration<double, std::milli>(filled - spans).count() / frames
+              << " ms, blue noise dithered " << std::chrono::duration<double, std::milli>(end - dithered).count() / frames << " ms" << std::endl;
+}
+
+int main()
+{
+    benchmark<GrayscaleImage>("grayscale", gradient::Gradient::Angle(0, 255, 30.0f), 20);
+    benchmark<ColorImage>("rgb", gradient::RGBGradient::Angle(RGBA(255, 0, 0), RGBA(0, 0, 255), 30.0f), 20);
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include "../Image.h"
+#include "../Gradient.h"
+
+// A shallow ramp spread over a wide image bands visibly in 8 bits. Each third of the image is
+// filled with a different dithering pattern: none, Bayer and blue noise.
+int main()
+{
+    ColorImage image(1024, 384);
+
+    auto gradient = gradient::RGBGradient::Horizontal(RGBA(20, 30, 60), RGBA(40, 45, 90));
+
+    gradient.prepareDirectional({512, 192}, {{0, 0}, {1023, 0}, {0, 383}, {1023, 383}});
+
+    dither::Pattern patterns[] = {dither::Pattern::NONE, dither::Pattern::BAYER, dither::Pattern::BLUE_NOISE};
+
+    for (int band = 0; band < 3; band++)
+    {
+        gradient.setDither(patterns[band]);
+
+        for (int y = band * 128; y < (band + 1) * 128; y++)
+        {
+            gradient.atSpan(&image(0, y), 0, y, image.GetWidth());
+        }
+    }
+
+    image.Save("dither.png");
+
+    GrayscaleImage grayscaleImage(1024, 128);
+
+    auto grayGradient = gradient::Gradient::Horizontal(64, 80);
+    grayGradient.setDither(dither::Pattern::BLUE_NOISE);
+
+    gradient::fillGradient(grayscaleImage, grayGradient);
+
+    grayscaleImage.Save("dither-grayscale.png");
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include "../Image.h"
+#include "../Gradient.h"
+
+// The same two-stop ramps interpolated in each color space, one band per space from top to
+// bottom: sRGB bytes, linear light, Oklab and CIELAB. Blue to yellow shows the gray dip of sRGB
+// mixing; blue to white shows the purple drift of CIELAB that Oklab avoids.
+int main()
+{
+    const color::Space spaces[] = {color::Space::SRGB, color::Space::LINEAR, color::Space::OKLAB, color::Space::LAB};
+    const int band = 64;
+
+    ColorImage image(512, 8 * band);
+
+    for (int i = 0; i < 4; i++)
+    {
+        gradient::RGBStopGradient blueToYellow = gradient::RGBStopGradient::Linear({0, 0}, {511, 0}, {{0.0f, RGBA(0, 0, 255)}, {1.0f, RGBA(255, 255, 0)}}, spaces[i]);
+        gradient::RGBStopGradient blueToWhite = gradient::RGBStopGradient::Linear({0, 0}, {511, 0}, {{0.0f, RGBA(0, 0, 255)}, {1.0f, RGBA(255, 255, 255)}}, spaces[i]);
+
+        for (int y = 0; y < band; y++)
+        {
+            blueToYellow.atSpan(&image(0, i * band + y), 0, y, image.GetWidth());
+            blueToWhite.atSpan(&image(0, (i + 4) * band + y), 0, y, image.GetWidth());
+        }
+    }
+
+    image.Save("spaces.png");
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "../Image.h"
+#include "../Polygon.h"
+
+std::vector<Point> square(Point corner, int size)
+{
+    return {corner, {corner.x + size, corner.y}, {corner.x + size, corner.y + size}, {corner.x, corner.y + size}};
+}
+
+int main()
+{
+    ColorImage image(512, 512);
+
+    gradient::RGBStopGradient::Stops rainbow = {
+        {0.0f, RGBA(255, 0, 0)},
+        {0.25f, RGBA(255, 255, 0)},
+        {0.5f, RGBA(0, 255, 0)},
+        {0.75f, RGBA(0, 0, 255)},
+        {1.0f, RGBA(255, 0, 0)}};
+
+    gradient::fillGradient(image, gradient::RGBStopGradient::Radial({256, 256}, 362, {{0.0f, RGBA(40, 40, 60)}, {1.0f, RGBA(0, 0, 0)}}));
+
+    polygon::drawPolygon(image, square({32, 32}, 192), gradient::RGBStopGradient::Linear({32, 32}, {224, 224}, rainbow));
+    polygon::drawPolygon(image, square({288, 32}, 192), gradient::RGBStopGradient::Conic({384, 128}, -90.0f, rainbow));
+    polygon::drawPolygon(image, square({32, 288}, 192), gradient::RGBStopGradient::Radial({128, 384}, 96, rainbow));
+    polygon::drawPolygon(image, square({288, 288}, 192), gradient::RGBStopGradient::Diamond({384, 384}, 96, rainbow));
+
+    image.Save("stops.png");
+
+    GrayscaleImage grayscaleImage(256, 256);
+
+    gradient::fillGradient(grayscaleImage, gradient::StopGradient::Linear({0, 0}, {255, 0}, {{0.0f, 0.0f}, {0.5f, 255.0f}, {0.5f, 64.0f}, {1.0f, 192.0f}}));
+
+    grayscaleImage.Save("stops-grayscale.png");
+
+    return 0;
+}
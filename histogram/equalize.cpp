@@ -0,0 +1,58 @@
+#include "../Image.h"
+#include "../Histogram.h"
+#include "../Noise.h"
+#include <chrono>
+#include <iostream>
+
+// A low contrast frame with a dark left half and a bright right half, run through global
+// equalization, auto-levels and CLAHE. Only CLAHE brings out the detail in both halves at once.
+int main()
+{
+    GrayscaleImage image(1920, 1080);
+    ColorImage color(image.GetWidth(), image.GetHeight());
+
+    noise::SimplexNoise simplexNoise(7);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            float detail = 0.5f * simplexNoise.noise(x * 0.003f, y * 0.003f) + 0.5f * simplexNoise.noise(x * 0.03f, y * 0.03f);
+            float base = x < image.GetWidth() / 2 ? 60.0f : 150.0f;
+
+            image(x, y) = (Byte)std::round(base + 30.0f * detail);
+            color(x, y) = RGBA(image(x, y), (Byte)(0.8f * image(x, y)), (Byte)(0.5f * image(x, y) + 20));
+        }
+    }
+
+    image.Save("low-contrast.png");
+
+    auto timed = [](const char *name, auto operation)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        operation();
+
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << name << " " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    };
+
+    GrayscaleImage equalized = image, levels = image, adaptive = image;
+
+    timed("equalize", [&]
+          { histogram::equalize(equalized, parallel::Execution::PARALLEL); });
+    timed("auto-levels", [&]
+          { histogram::autoLevels(levels, 0.005f, parallel::Execution::PARALLEL); });
+    timed("clahe", [&]
+          { histogram::clahe(adaptive, 8, 8, 2.0f, parallel::Execution::PARALLEL); });
+    timed("equalize luma", [&]
+          { histogram::equalize(color, luma::Weights::REC601, parallel::Execution::PARALLEL); });
+
+    equalized.Save("equalized.png");
+    levels.Save("auto-levels.png");
+    adaptive.Save("clahe.png");
+    color.Save("equalized-color.png");
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "../Image.h"
+#include "../Histogram.h"
+#include "../Noise.h"
+#include <chrono>
+#include <iostream>
+
+// Counts a 1920x1080 noise image every way the histogram module offers, then draws the counts.
+// Counting is timed on its own, since drawing is a separate step now.
+int main()
+{
+    ColorImage image(1920, 1080);
+
+    noise::SimplexNoise simplexNoise(12345);
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            float low = simplexNoise.noise(x * 0.004f, y * 0.004f), high = simplexNoise.noise(x * 0.05f, y * 0.05f);
+
+            image(x, y) = RGBA((Byte)std::round((low + 1.0f) * 127.5f),
+                               (Byte)std::round((0.7f * low + 0.3f * high + 1.0f) * 127.5f),
+                               (Byte)std::round((high + 1.0f) * 127.5f));
+        }
+    }
+
+    GrayscaleImage gray(image);
+
+    auto start = std::chrono::steady_clock::now();
+
+    histogram::Counts levels = histogram::count(gray, parallel::Execution::PARALLEL);
+    histogram::ChannelCounts channels = histogram::channels(image, parallel::Execution::PARALLEL);
+    histogram::Counts luminance = histogram::luminance(image, luma::Weights::REC709, parallel::Execution::PARALLEL);
+    histogram::Joint joint = histogram::joint(image, histogram::Channel::RED, histogram::Channel::GREEN, 128, parallel::Execution::PARALLEL);
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "counted in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    histogram::render(levels, 0.01).Save("histogram-gray.png");
+    histogram::render(channels, 0.01).Save("histogram-channels.png");
+    histogram::render(luminance, 0.01).Save("histogram-luminance.png");
+    histogram::render(joint).Save("histogram-red-green.png");
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "../Image.h"
+#include "../Path.h"
+
+path::Path heart(Point center, int size)
+{
+    path::Path shape;
+
+    shape.moveTo({center.x, center.y + size})
+        .cubicTo({center.x - 2 * size, center.y}, {center.x - size, center.y - size}, {center.x, center.y - size / 3})
+        .cubicTo({center.x + size, center.y - size}, {center.x + 2 * size, center.y}, {center.x, center.y + size})
+        .close();
+
+    return shape;
+}
+
+path::Path ring(Point center, int outer, int inner)
+{
+    // A circle is four cubic arcs whose control points sit at 0.5523 of the radius
+    auto circle = [&](path::Path &shape, int radius)
+    {
+        int k = std::round(radius * 0.5523f);
+
+        shape.moveTo({center.x + radius, center.y})
+            .cubicTo({center.x + radius, center.y + k}, {center.x + k, center.y + radius}, {center.x, center.y + radius})
+            .cubicTo({center.x - k, center.y + radius}, {center.x - radius, center.y + k}, {center.x - radius, center.y})
+            .cubicTo({center.x - radius, center.y - k}, {center.x - k, center.y - radius}, {center.x, center.y - radius})
+            .cubicTo({center.x + k, center.y - radius}, {center.x + radius, center.y - k}, {center.x + radius, center.y})
+            .close();
+    };
+
+    path::Path shape;
+
+    circle(shape, outer);
+    circle(shape, inner);
+
+    return shape;
+}
+
+int main()
+{
+    ColorImage image(256, 256);
+
+    path::Path shape = heart({128, 120}, 80);
+
+    path::fillPath(image, shape, gradient::RGBGradient::Vertical(RGBA(255, 64, 64), RGBA(128, 0, 64)));
+    path::strokePath(image, shape, RGBA(255, 255, 255), 4.0f);
+
+    image.Save("heart.png");
+
+    GrayscaleImage ringImage(256, 256);
+
+    path::Path donut = ring({128, 128}, 100, 50);
+
+    path::fillPath(ringImage, donut, 128, path::WindingRule::ODD);
+    path::strokePath(ringImage, donut, 255);
+
+    ringImage.Save("ring.png");
+
+    path::Path wave;
+
+    wave.moveTo({16, 128}).quadTo({72, 16}, {128, 128}).quadTo({184, 240}, {240, 128});
+
+    GrayscaleImage waveImage(256, 256);
+
+    path::strokePath(waveImage, wave, 255, 6.0f);
+
+    waveImage.Save("wave.png");
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "../Image.h"
+#include "../Polygon.h"
+#include <chrono>
+#include <random>
+
+// A choropleth-like tiling: one jittered quad per grid cell, each with its own color
+std::vector<std::vector<Point>> randomTiles(int width, int height, int cell, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<int> jitter(-cell / 4, cell / 4);
+
+    int columns = width / cell + 1, rows = height / cell + 1;
+
+    std::vector<Point> corners((columns + 1) * (rows + 1));
+
+    for (int y = 0; y <= rows; y++)
+    {
+        for (int x = 0; x <= columns; x++)
+        {
+            corners[x + y * (columns + 1)] = {x * cell + jitter(generator), y * cell + jitter(generator)};
+        }
+    }
+
+    std::vector<std::vector<Point>> tiles;
+
+    for (int y = 0; y < rows; y++)
+    {
+        for (int x = 0; x < columns; x++)
+        {
+            int i = x + y * (columns + 1);
+            tiles.push_back({corners[i], corners[i + 1], corners[i + columns + 2], corners[i + columns + 1]});
+        }
+    }
+
+    return tiles;
+}
+
+int main()
+{
+    int width = 1024, height = 1024;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> channel(0, 255);
+
+    std::vector<std::vector<Point>> tiles = randomTiles(width, height, 2, generator);
+    std::vector<RGBA> colors;
+
+    for (int i = 0; i < (int)tiles.size(); i++)
+    {
+        colors.push_back(RGBA(channel(generator), channel(generator), channel(generator)));
+    }
+
+    ColorImage single(width, height), batched(width, height);
+
+    // Several frames, as when rendering tiles: the batch keeps its buffers between them
+    int frames = 4;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (int i = 0; i < (int)tiles.size(); i++)
+        {
+            polygon::drawPolygon(single, tiles[i], colors[i], colors[i]);
+        }
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+
+    polygon::Batch<RGBA> batch;
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        batch.clear();
+
+        for (int i = 0; i < (int)tiles.size(); i++)
+        {
+            batch.add(tiles[i], colors[i]);
+        }
+
+        batch.draw(batched);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << tiles.size() << " polygons per frame, one by one: " << std::chrono::duration<double, std::milli>(middle - start).count() / frames
+              << " ms, batched: " << std::chrono::duration<double, std::milli>(end - middle).count() / frames << " ms" << std::endl;
+
+    batched.Save("batch.png");
+
+    return 0;
+}
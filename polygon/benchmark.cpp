@@ -0,0 +1,65 @@
+#include "../Image.h"
+#include "../Polygon.h"
+#include <chrono>
+#include <random>
+
+// Outline of a wavy blob with `count` vertices. With `jagged` every vertex gets a random
+// radius, so edges cross on nearly every row; otherwise the outline stays smooth like a
+// map region and only a handful of edges are active per row.
+std::vector<Point> randomPolygon(int count, Point center, int radius, bool jagged, std::mt19937 &generator)
+{
+    std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+    std::vector<Point> points(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        float theta = 2 * M_PI * i / count;
+        float r = jagged ? radius * (0.65f + 0.35f * jitter(generator)) : radius * (0.8f + 0.2f * sin(7 * theta)) + jitter(generator);
+
+        points[i] = {int(std::round(center.x + r * cos(theta))), int(std::round(center.y + r * sin(theta)))};
+    }
+
+    return points;
+}
+
+int main()
+{
+    std::cout << parallel::threadCount() << " threads" << std::endl;
+
+    GrayscaleImage image(1024, 1024);
+
+    std::mt19937 generator(42);
+
+    for (bool jagged : {false, true})
+    {
+        for (int count = 10; count <= 1000000; count *= 10)
+        {
+            std::vector<Point> points = randomPolygon(count, {512, 512}, 500, jagged, generator);
+
+            for (auto windingRule : {polygon::WindingRule::ODD, polygon::WindingRule::POSITIVE})
+            {
+                std::cout << (jagged ? "jagged, " : "smooth, ") << count << " vertices, "
+                          << (windingRule == polygon::WindingRule::ODD ? "odd" : "positive");
+
+                for (auto execution : {parallel::Execution::SERIAL, parallel::Execution::PARALLEL})
+                {
+                    auto start = std::chrono::steady_clock::now();
+
+                    polygon::drawPolygon(image, points, 255, 255, windingRule, execution);
+
+                    auto end = std::chrono::steady_clock::now();
+
+                    std::cout << (execution == parallel::Execution::SERIAL ? ": serial " : ", parallel ")
+                              << std::chrono::duration<double, std::milli>(end - start).count() << " ms";
+                }
+
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    image.Save("polygonBenchmark.png");
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "../Image.h"
+#include "../Polygon.h"
+#include <random>
+
+// A jittered triangle mesh filled twice: once with vertices rounded to whole pixels and drawn
+// like before, once with the exact sub-pixel vertices. Every triangle adds 1 to the pixels it
+// covers, so anything other than the single mid-gray shows overlap (brighter) or a crack (black).
+int main()
+{
+    const int cells = 16;
+    const float cell = 16.0f;
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> jitter(-0.25f * cell, 0.25f * cell);
+
+    std::vector<std::vector<curve::FloatPoint>> grid(cells + 1, std::vector<curve::FloatPoint>(cells + 1));
+
+    for (int i = 0; i <= cells; i++)
+    {
+        for (int j = 0; j <= cells; j++)
+        {
+            grid[i][j] = {j * cell + jitter(generator), i * cell + jitter(generator)};
+        }
+    }
+
+    std::vector<std::vector<curve::FloatPoint>> triangles;
+
+    for (int i = 0; i < cells; i++)
+    {
+        for (int j = 0; j < cells; j++)
+        {
+            triangles.push_back({grid[i][j], grid[i][j + 1], grid[i + 1][j + 1]});
+            triangles.push_back({grid[i][j], grid[i + 1][j + 1], grid[i + 1][j]});
+        }
+    }
+
+    int size = int(cells * cell);
+
+    GrayscaleImage rounded(size, size), exact(size, size);
+
+    for (const auto &triangle : triangles)
+    {
+        std::vector<Point> points;
+
+        for (curve::FloatPoint point : triangle)
+        {
+            points.push_back(point);
+        }
+
+        GrayscaleImage single(size, size), exactSingle(size, size);
+
+        polygon::drawPolygon(single, points, 1, 1);
+        polygon::fillPolygon(exactSingle, triangle, 1);
+
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                rounded(x, y) += single(x, y) * 80;
+                exact(x, y) += exactSingle(x, y) * 80;
+            }
+        }
+    }
+
+    rounded.Save("rounded.png");
+    exact.Save("watertight.png");
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include "../Image.h"
+#include "../Curve.h"
+
+void drawRoseCurveAdaptive(GrayscaleImage &image, const Point &center, int petals, float scale = 0, Byte color = 255)
+{
+    if (petals <= 0)
+    {
+        std::cerr << "Petals must be positive." << std::endl;
+        return;
+    }
+
+    if (scale <= 0)
+    {
+        scale = image.GetWidth() / 2 - 10;
+    }
+
+    curve::drawPolar(image, center, [&](float theta) { return cos(petals * theta) * scale; }, 0, 2 * M_PI, color);
+}
+
+int main()
+{
+    GrayscaleImage image(256, 256);
+
+    Point center = {128, 128};
+
+    int petals = 4;
+
+    drawRoseCurveAdaptive(image, center, petals);
+
+    image.Save("roseCurveAdaptive.png");
+
+    return 0;
+}
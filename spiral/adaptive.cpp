@@ -0,0 +1,44 @@
+#include "../Image.h"
+#include "../Curve.h"
+
+void drawSpiralAdaptive(GrayscaleImage &image, const Point &center, int intercept, float factor, int loops, Byte color = 255)
+{
+    if (intercept < 0)
+    {
+        std::cerr << "Intercept must not be negative." << std::endl;
+        return;
+    }
+    if (factor <= 0.0f)
+    {
+        std::cerr << "Factor must be positive." << std::endl;
+        return;
+    }
+    if (loops <= 0)
+    {
+        std::cerr << "Loops must be positive." << std::endl;
+        return;
+    }
+
+    auto radius = [&](float theta) { return intercept + (factor * theta) / (2.0f * M_PI); };
+
+    curve::drawPolar(image, center, radius, 0, 2 * M_PI * loops, color, 0.5f, 4 * loops);
+}
+
+int main()
+{
+    GrayscaleImage image(256, 256);
+
+    Point center = {128, 128};
+
+    int intercept = 5;
+
+    float factor = 8.0f;
+
+    int loops = 10;
+
+    drawSpiralAdaptive(image, center, intercept, factor, loops);
+
+    image.Save("spiralAdaptive.png");
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include "../Circle.h"
 #include "../Polygon.h"
 #include "../Curve.h"
+#include "../Resize.h"
 
 enum class SamplingFactor
 {
@@ -53,31 +54,10 @@ public:
         return sampled;
     }
 
+    // Each original pixel becomes the mean of its factor x factor block of samples
     ~SuperSampleImage()
     {
-        for (int y = 0; y < original.GetHeight(); y++)
-        {
-            for (int x = 0; x < original.GetWidth(); x++)
-            {
-                int total = 0;
-
-                for (int dy = 0; dy < factor; dy++)
-                {
-                    for (int dx = 0; dx < factor; dx++)
-                    {
-                        int sx = x * factor + dx;
-                        int sy = y * factor + dy;
-
-                        if (sx < sampled.GetWidth() && sy < sampled.GetHeight())
-                        {
-                            total += sampled(sx, sy);
-                        }
-                    }
-                }
-
-                original(x, y) = std::round(total / (float)factor);
-            }
-        }
+        original = resize::resize(sampled, original.GetWidth(), original.GetHeight(), resize::Method::BOX);
     }
 };
 